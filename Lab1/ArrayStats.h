@@ -0,0 +1,126 @@
+// Allen Lim
+
+/** Single-pass reduction computing several order statistics of an
+ array segment at once.
+ @file ArrayStats.h */
+
+#ifndef ARRAY_STATS_
+#define ARRAY_STATS_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "MaxArray.h"
+
+// Statistics reduceArray can compute; combine with |.
+enum StatFlags : unsigned
+{
+	StatMin = 1u << 0,
+	StatMax = 1u << 1,
+	StatArgMin = 1u << 2,
+	StatArgMax = 1u << 3,
+	StatTopK = 1u << 4
+};
+
+// Fields not requested are left value-initialized (indices stay -1).
+template<class ElementType>
+struct ArrayStats
+{
+	ElementType min{};
+	ElementType max{};
+	int argMin = -1;
+	int argMax = -1;
+	std::vector<ElementType> topK;  // largest first
+};
+
+// Computes the statistics selected by Stats over array[first..last]
+// (inclusive, first <= last) in one pass. Ties resolve to the leftmost
+// element, as in maxArray; topK holds the k largest elements in
+// descending order, kept in a bounded min-heap of size k.
+template<unsigned Stats, class ElementType>
+ArrayStats<ElementType> reduceArray(const ElementType array[], int first, int last, std::size_t k = 0)
+{
+	constexpr bool wantMin = (Stats & (StatMin | StatArgMin)) != 0;
+	constexpr bool wantMax = (Stats & (StatMax | StatArgMax)) != 0;
+	constexpr bool wantTopK = (Stats & StatTopK) != 0;
+
+	ArrayStats<ElementType> stats;
+	if (Stats == StatMax)
+	{
+		// Plain maximum: use the SIMD kernels where they apply.
+		stats.max = maxArray(array, first, last);
+		return stats;
+	}
+
+	auto heapOrder = [](const ElementType& a, const ElementType& b) { return b < a; };
+	auto offer = [&stats, k, &heapOrder](const ElementType& item)
+	{
+		if (stats.topK.size() < k)
+		{
+			stats.topK.push_back(item);
+			std::push_heap(stats.topK.begin(), stats.topK.end(), heapOrder);
+		}
+		else if (k > 0 && stats.topK.front() < item)
+		{
+			std::pop_heap(stats.topK.begin(), stats.topK.end(), heapOrder);
+			stats.topK.back() = item;
+			std::push_heap(stats.topK.begin(), stats.topK.end(), heapOrder);
+		}
+	};
+	if (wantTopK)
+		stats.topK.reserve(k);
+
+	const ElementType* minPtr = array + first;
+	const ElementType* maxPtr = array + first;
+	int i = first;
+	if (wantTopK)
+		offer(array[i]);
+	i++;
+
+	// With both ends requested, order each pair first so every element
+	// costs 1.5 comparisons instead of 2.
+	if (wantMin && wantMax)
+	{
+		for (; i < last; i += 2)
+		{
+			const ElementType* a = array + i;
+			const ElementType* b = array + i + 1;
+			const ElementType* small = (*b < *a) ? b : a;
+			const ElementType* large = (*a < *b) ? b : a;
+			if (*small < *minPtr)
+				minPtr = small;
+			if (*maxPtr < *large)
+				maxPtr = large;
+			if (wantTopK)
+			{
+				offer(*a);
+				offer(*b);
+			}
+		}
+	}
+
+	for (; i <= last; i++)
+	{
+		const ElementType* p = array + i;
+		if (wantMin && *p < *minPtr)
+			minPtr = p;
+		if (wantMax && *maxPtr < *p)
+			maxPtr = p;
+		if (wantTopK)
+			offer(*p);
+	}
+
+	if (Stats & StatMin)
+		stats.min = *minPtr;
+	if (Stats & StatMax)
+		stats.max = *maxPtr;
+	if (Stats & StatArgMin)
+		stats.argMin = static_cast<int>(minPtr - array);
+	if (Stats & StatArgMax)
+		stats.argMax = static_cast<int>(maxPtr - array);
+	if (wantTopK)
+		std::sort_heap(stats.topK.begin(), stats.topK.end(), heapOrder);
+	return stats;
+}  // end reduceArray
+
+#endif
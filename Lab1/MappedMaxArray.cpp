@@ -0,0 +1,94 @@
+// Allen Lim
+
+/** Window-by-window memory mapping for maxArrayFile.
+ @file MappedMaxArray.cpp */
+
+#include "MappedMaxArray.h"
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Closes the descriptor on every exit path.
+class FileHandle
+{
+private:
+	int fd;
+public:
+	explicit FileHandle(int afd) : fd(afd) {}
+	FileHandle(const FileHandle&) = delete;
+	FileHandle& operator=(const FileHandle&) = delete;
+	~FileHandle() { if (fd >= 0) close(fd); }
+	int get() const { return fd; }
+};
+
+std::runtime_error fileError(const std::string& what, const std::string& path)
+{
+	return std::runtime_error(what + " '" + path + "': " + std::strerror(errno));
+}  // end fileError
+
+}  // end namespace
+
+void forEachFileWindow(const std::string& path, std::size_t windowBytes, std::size_t elementSize,
+                       const std::function<void(const void* data, std::size_t bytes)>& visit)
+{
+	FileHandle file(open(path.c_str(), O_RDONLY));
+	if (file.get() < 0)
+		throw fileError("cannot open", path);
+	struct stat info;
+	if (fstat(file.get(), &info) != 0)
+		throw fileError("cannot stat", path);
+	const std::size_t fileBytes = static_cast<std::size_t>(info.st_size);
+	if (fileBytes == 0)
+		throw std::runtime_error("empty file '" + path + "'");
+	if (fileBytes % elementSize != 0)
+		throw std::runtime_error("size of '" + path + "' is not a multiple of the element size");
+
+	// Round the window to whole pages; every power-of-two element size
+	// divides the page size, so no element straddles two windows.
+	const std::size_t pageBytes = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+	if (pageBytes % elementSize != 0)
+		throw std::runtime_error("element size must divide the page size");
+	const std::size_t maxWindow = std::size_t(1) << 30;
+	windowBytes = std::min(std::max(windowBytes, pageBytes), maxWindow) / pageBytes * pageBytes;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(file.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+	for (std::size_t offset = 0; offset < fileBytes; offset += windowBytes)
+	{
+		const std::size_t bytes = std::min(windowBytes, fileBytes - offset);
+		void* window = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, file.get(), static_cast<off_t>(offset));
+		if (window == MAP_FAILED)
+			throw fileError("cannot map", path);
+		madvise(window, bytes, MADV_SEQUENTIAL);
+		try
+		{
+			visit(window, bytes);
+		}
+		catch (...)
+		{
+			munmap(window, bytes);
+			throw;
+		}
+		munmap(window, bytes);
+	}
+}  // end forEachFileWindow
+
+#else
+
+void forEachFileWindow(const std::string& path, std::size_t, std::size_t,
+                       const std::function<void(const void* data, std::size_t bytes)>&)
+{
+	throw std::runtime_error("memory-mapped files are not supported on this platform: '" + path + "'");
+}  // end forEachFileWindow
+
+#endif
@@ -0,0 +1,47 @@
+// Allen Lim
+
+/** maxArray over flat binary files, streamed through memory-mapped
+ windows so files larger than RAM reduce in constant memory.
+ @file MappedMaxArray.h */
+
+#ifndef MAPPED_MAX_ARRAY_
+#define MAPPED_MAX_ARRAY_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include "MaxArray.h"
+
+// Default bytes mapped at a time.
+const std::size_t DEFAULT_MAP_WINDOW = std::size_t(64) << 20;
+
+// Maps the file at path one window at a time and calls visit(data, bytes)
+// for each window in file order. Windows start on page boundaries, hold a
+// whole number of elementSize-byte elements and are unmapped before the
+// next one is mapped. Throws std::runtime_error if the file cannot be
+// opened or mapped, is empty, or its size is not a multiple of elementSize.
+void forEachFileWindow(const std::string& path, std::size_t windowBytes, std::size_t elementSize,
+                       const std::function<void(const void* data, std::size_t bytes)>& visit);
+
+// Returns the largest ElementType in a file of native-endian ElementType
+// values, e.g. int32 or float64 dumps. Each window is reduced with maxArray,
+// so int, float and double files use the SIMD kernels.
+template<class ElementType>
+ElementType maxArrayFile(const std::string& path, std::size_t windowBytes = DEFAULT_MAP_WINDOW)
+{
+	static_assert(std::is_arithmetic<ElementType>::value, "maxArrayFile reads raw arithmetic values");
+	bool seen = false;
+	ElementType result = ElementType();
+	forEachFileWindow(path, windowBytes, sizeof(ElementType), [&](const void* data, std::size_t bytes)
+	{
+		const ElementType* items = static_cast<const ElementType*>(data);
+		ElementType windowMax = maxArray(items, 0, static_cast<int>(bytes / sizeof(ElementType)) - 1);
+		result = seen ? std::max(result, windowMax) : windowMax;
+		seen = true;
+	});
+	return result;
+}  // end maxArrayFile
+
+#endif
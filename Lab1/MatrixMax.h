@@ -0,0 +1,61 @@
+// Allen Lim
+
+/** Row, column and whole-matrix maxima of a row-major 2-D array whose
+ rows start rowStride elements apart (rowStride >= cols, so padded
+ rows and sub-matrices work too).
+ @file MatrixMax.h */
+
+#ifndef MATRIX_MAX_
+#define MATRIX_MAX_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include "MaxArray.h"
+
+// Width of a column tile for columnMaxArray. One tile of maxima stays
+// in L1 while every row contributes its matching contiguous slice.
+const std::size_t COLUMN_TILE_BYTES = 16 * 1024;
+
+// rowMax[r] = largest element of row r, for r < rows (cols >= 1).
+template<class ElementType>
+void rowMaxArray(const ElementType matrix[], int rows, int cols, std::size_t rowStride,
+                 ElementType rowMax[])
+{
+	for (int r = 0; r < rows; r++)
+		rowMax[r] = maxArray(matrix + r * rowStride, 0, cols - 1);
+}  // end rowMaxArray
+
+// columnMax[c] = largest element of column c, for c < cols (rows >= 1).
+// Reading a column straight down a row-major matrix misses the cache on
+// every element; instead the columns are cut into tiles and each tile is
+// folded row by row with the element-wise maxArrayInto kernel, so every
+// access is a contiguous, vectorized run.
+template<class ElementType>
+void columnMaxArray(const ElementType matrix[], int rows, int cols, std::size_t rowStride,
+                    ElementType columnMax[])
+{
+	const std::size_t tile = std::max<std::size_t>(COLUMN_TILE_BYTES / sizeof(ElementType), 1);
+	for (std::size_t c = 0; c < static_cast<std::size_t>(cols); c += tile)
+	{
+		const std::size_t width = std::min(tile, cols - c);
+		std::copy(matrix + c, matrix + c + width, columnMax + c);
+		for (int r = 1; r < rows; r++)
+			maxArrayInto(columnMax + c, matrix + r * rowStride + c, width);
+	}
+}  // end columnMaxArray
+
+// Largest element of the whole matrix (rows, cols >= 1).
+template<class ElementType>
+ElementType matrixMaxArray(const ElementType matrix[], int rows, int cols, std::size_t rowStride)
+{
+	// Unpadded matrices are one contiguous run; padding is skipped per row.
+	if (rowStride == static_cast<std::size_t>(cols) && static_cast<long long>(rows) * cols <= std::numeric_limits<int>::max())
+		return maxArray(matrix, 0, rows * cols - 1);
+	ElementType result = maxArray(matrix, 0, cols - 1);
+	for (int r = 1; r < rows; r++)
+		result = std::max(result, maxArray(matrix + r * rowStride, 0, cols - 1));
+	return result;
+}  // end matrixMaxArray
+
+#endif
@@ -0,0 +1,450 @@
+// Allen Lim
+
+/** SIMD kernels and runtime dispatch for maxArray.
+ @file MaxArray.cpp */
+
+#include "MaxArray.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MAX_ARRAY_X86_
+#include <immintrin.h>
+#endif
+
+namespace
+{
+
+template<class T>
+T maxScalar(const T array[], std::size_t count)
+{
+	T result = array[0];
+	for (std::size_t i = 1; i < count; i++)
+		result = std::max(result, array[i]);
+	return result;
+}  // end maxScalar
+
+template<class T>
+void maxIntoScalar(T acc[], const T items[], std::size_t count)
+{
+	for (std::size_t i = 0; i < count; i++)
+		acc[i] = std::max(acc[i], items[i]);
+}  // end maxIntoScalar
+
+#ifdef MAX_ARRAY_X86_
+
+//------------------------------------------------------------
+// Lane operations. Each struct wraps the intrinsics one kernel
+// needs for one element type and one instruction set.
+//------------------------------------------------------------
+
+struct IntSse2
+{
+	using Scalar = int;
+	using Vec = __m128i;
+	static constexpr std::size_t lanes = 4;
+	__attribute__((target("sse2"))) static Vec load(const int* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+	__attribute__((target("sse2"))) static void store(int* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	// SSE2 has no packed 32-bit max; select through a compare mask.
+	__attribute__((target("sse2"))) static Vec max(Vec a, Vec b)
+	{
+		Vec mask = _mm_cmpgt_epi32(a, b);
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+};
+
+struct FloatSse2
+{
+	using Scalar = float;
+	using Vec = __m128;
+	static constexpr std::size_t lanes = 4;
+	__attribute__((target("sse2"))) static Vec load(const float* p) { return _mm_loadu_ps(p); }
+	__attribute__((target("sse2"))) static void store(float* p, Vec v) { _mm_storeu_ps(p, v); }
+	__attribute__((target("sse2"))) static Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+};
+
+struct DoubleSse2
+{
+	using Scalar = double;
+	using Vec = __m128d;
+	static constexpr std::size_t lanes = 2;
+	__attribute__((target("sse2"))) static Vec load(const double* p) { return _mm_loadu_pd(p); }
+	__attribute__((target("sse2"))) static void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+	__attribute__((target("sse2"))) static Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+};
+
+struct IntAvx2
+{
+	using Scalar = int;
+	using Vec = __m256i;
+	static constexpr std::size_t lanes = 8;
+	__attribute__((target("avx2"))) static Vec load(const int* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+	__attribute__((target("avx2"))) static void store(int* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	__attribute__((target("avx2"))) static Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+};
+
+struct FloatAvx2
+{
+	using Scalar = float;
+	using Vec = __m256;
+	static constexpr std::size_t lanes = 8;
+	__attribute__((target("avx2"))) static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+	__attribute__((target("avx2"))) static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+	__attribute__((target("avx2"))) static Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+};
+
+struct DoubleAvx2
+{
+	using Scalar = double;
+	using Vec = __m256d;
+	static constexpr std::size_t lanes = 4;
+	__attribute__((target("avx2"))) static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+	__attribute__((target("avx2"))) static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+	__attribute__((target("avx2"))) static Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+};
+
+struct IntAvx512
+{
+	using Scalar = int;
+	using Vec = __m512i;
+	static constexpr std::size_t lanes = 16;
+	__attribute__((target("avx512f"))) static Vec load(const int* p) { return _mm512_loadu_si512(p); }
+	__attribute__((target("avx512f"))) static void store(int* p, Vec v) { _mm512_storeu_si512(p, v); }
+	__attribute__((target("avx512f"))) static Vec max(Vec a, Vec b) { return _mm512_max_epi32(a, b); }
+};
+
+struct FloatAvx512
+{
+	using Scalar = float;
+	using Vec = __m512;
+	static constexpr std::size_t lanes = 16;
+	__attribute__((target("avx512f"))) static Vec load(const float* p) { return _mm512_loadu_ps(p); }
+	__attribute__((target("avx512f"))) static void store(float* p, Vec v) { _mm512_storeu_ps(p, v); }
+	__attribute__((target("avx512f"))) static Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+};
+
+struct DoubleAvx512
+{
+	using Scalar = double;
+	using Vec = __m512d;
+	static constexpr std::size_t lanes = 8;
+	__attribute__((target("avx512f"))) static Vec load(const double* p) { return _mm512_loadu_pd(p); }
+	__attribute__((target("avx512f"))) static void store(double* p, Vec v) { _mm512_storeu_pd(p, v); }
+	__attribute__((target("avx512f"))) static Vec max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+};
+
+//------------------------------------------------------------
+// Kernels. Four independent accumulators hide the latency of
+// the max instruction; one-vector steps and a scalar tail
+// finish whatever the unrolled loop leaves over. The loop body
+// is repeated per instruction set because the target attribute
+// must sit on the function the intrinsics are inlined into.
+//------------------------------------------------------------
+
+// Folds the lanes spilled by a kernel together with the scalar tail
+// array[i..count).
+template<class T>
+T finishLanes(const T lanes[], std::size_t laneCount, const T array[],
+              std::size_t i, std::size_t count)
+{
+	T result = maxScalar(lanes, laneCount);
+	for (; i < count; i++)
+		result = std::max(result, array[i]);
+	return result;
+}  // end finishLanes
+
+template<class Ops>
+__attribute__((target("sse2")))
+typename Ops::Scalar maxSse2(const typename Ops::Scalar array[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	if (count < w)
+		return maxScalar(array, count);
+	typename Ops::Vec a0 = Ops::load(array), a1 = a0, a2 = a0, a3 = a0;
+	std::size_t i = w;
+	for (; i + 4 * w <= count; i += 4 * w)
+	{
+		a0 = Ops::max(a0, Ops::load(array + i));
+		a1 = Ops::max(a1, Ops::load(array + i + w));
+		a2 = Ops::max(a2, Ops::load(array + i + 2 * w));
+		a3 = Ops::max(a3, Ops::load(array + i + 3 * w));
+	}
+	for (; i + w <= count; i += w)
+		a0 = Ops::max(a0, Ops::load(array + i));
+	a0 = Ops::max(Ops::max(a0, a1), Ops::max(a2, a3));
+	typename Ops::Scalar lanes[Ops::lanes];
+	Ops::store(lanes, a0);
+	return finishLanes(lanes, Ops::lanes, array, i, count);
+}  // end maxSse2
+
+template<class Ops>
+__attribute__((target("avx2")))
+typename Ops::Scalar maxAvx2(const typename Ops::Scalar array[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	if (count < w)
+		return maxScalar(array, count);
+	typename Ops::Vec a0 = Ops::load(array), a1 = a0, a2 = a0, a3 = a0;
+	std::size_t i = w;
+	for (; i + 4 * w <= count; i += 4 * w)
+	{
+		a0 = Ops::max(a0, Ops::load(array + i));
+		a1 = Ops::max(a1, Ops::load(array + i + w));
+		a2 = Ops::max(a2, Ops::load(array + i + 2 * w));
+		a3 = Ops::max(a3, Ops::load(array + i + 3 * w));
+	}
+	for (; i + w <= count; i += w)
+		a0 = Ops::max(a0, Ops::load(array + i));
+	a0 = Ops::max(Ops::max(a0, a1), Ops::max(a2, a3));
+	typename Ops::Scalar lanes[Ops::lanes];
+	Ops::store(lanes, a0);
+	return finishLanes(lanes, Ops::lanes, array, i, count);
+}  // end maxAvx2
+
+template<class Ops>
+__attribute__((target("avx512f")))
+typename Ops::Scalar maxAvx512(const typename Ops::Scalar array[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	if (count < w)
+		return maxScalar(array, count);
+	typename Ops::Vec a0 = Ops::load(array), a1 = a0, a2 = a0, a3 = a0;
+	std::size_t i = w;
+	for (; i + 4 * w <= count; i += 4 * w)
+	{
+		a0 = Ops::max(a0, Ops::load(array + i));
+		a1 = Ops::max(a1, Ops::load(array + i + w));
+		a2 = Ops::max(a2, Ops::load(array + i + 2 * w));
+		a3 = Ops::max(a3, Ops::load(array + i + 3 * w));
+	}
+	for (; i + w <= count; i += w)
+		a0 = Ops::max(a0, Ops::load(array + i));
+	a0 = Ops::max(Ops::max(a0, a1), Ops::max(a2, a3));
+	typename Ops::Scalar lanes[Ops::lanes];
+	Ops::store(lanes, a0);
+	return finishLanes(lanes, Ops::lanes, array, i, count);
+}  // end maxAvx512
+
+// Element-wise kernels: acc[i] = max(acc[i], items[i]).
+
+template<class Ops>
+__attribute__((target("sse2")))
+void maxIntoSse2(typename Ops::Scalar acc[], const typename Ops::Scalar items[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	std::size_t i = 0;
+	for (; i + w <= count; i += w)
+		Ops::store(acc + i, Ops::max(Ops::load(acc + i), Ops::load(items + i)));
+	maxIntoScalar(acc + i, items + i, count - i);
+}  // end maxIntoSse2
+
+template<class Ops>
+__attribute__((target("avx2")))
+void maxIntoAvx2(typename Ops::Scalar acc[], const typename Ops::Scalar items[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	std::size_t i = 0;
+	for (; i + w <= count; i += w)
+		Ops::store(acc + i, Ops::max(Ops::load(acc + i), Ops::load(items + i)));
+	maxIntoScalar(acc + i, items + i, count - i);
+}  // end maxIntoAvx2
+
+template<class Ops>
+__attribute__((target("avx512f")))
+void maxIntoAvx512(typename Ops::Scalar acc[], const typename Ops::Scalar items[], std::size_t count)
+{
+	const std::size_t w = Ops::lanes;
+	std::size_t i = 0;
+	for (; i + w <= count; i += w)
+		Ops::store(acc + i, Ops::max(Ops::load(acc + i), Ops::load(items + i)));
+	maxIntoScalar(acc + i, items + i, count - i);
+}  // end maxIntoAvx512
+
+SimdLevel probeSimdLevel()
+{
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		return SimdLevel::AVX512;
+	if (__builtin_cpu_supports("avx2"))
+		return SimdLevel::AVX2;
+	if (__builtin_cpu_supports("sse2"))
+		return SimdLevel::SSE2;
+	return SimdLevel::Scalar;
+}  // end probeSimdLevel
+
+#else
+
+SimdLevel probeSimdLevel()
+{
+	return SimdLevel::Scalar;
+}  // end probeSimdLevel
+
+#endif
+
+SimdLevel usableLevel(SimdLevel requested)
+{
+	SimdLevel best = detectSimdLevel();
+	return (requested > best) ? best : requested;
+}  // end usableLevel
+
+}  // end namespace
+
+SimdLevel detectSimdLevel()
+{
+	static const SimdLevel level = probeSimdLevel();
+	return level;
+}  // end detectSimdLevel
+
+const char* simdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::SSE2:
+		return "sse2";
+	case SimdLevel::AVX2:
+		return "avx2";
+	case SimdLevel::AVX512:
+		return "avx512";
+	default:
+		return "scalar";
+	}
+}  // end simdLevelName
+
+int maxArraySimd(const int array[], std::size_t count, SimdLevel level)
+{
+	switch (usableLevel(level))
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		return maxAvx512<IntAvx512>(array, count);
+	case SimdLevel::AVX2:
+		return maxAvx2<IntAvx2>(array, count);
+	case SimdLevel::SSE2:
+		return maxSse2<IntSse2>(array, count);
+#endif
+	default:
+		return maxScalar(array, count);
+	}
+}  // end maxArraySimd
+
+float maxArraySimd(const float array[], std::size_t count, SimdLevel level)
+{
+	switch (usableLevel(level))
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		return maxAvx512<FloatAvx512>(array, count);
+	case SimdLevel::AVX2:
+		return maxAvx2<FloatAvx2>(array, count);
+	case SimdLevel::SSE2:
+		return maxSse2<FloatSse2>(array, count);
+#endif
+	default:
+		return maxScalar(array, count);
+	}
+}  // end maxArraySimd
+
+double maxArraySimd(const double array[], std::size_t count, SimdLevel level)
+{
+	switch (usableLevel(level))
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		return maxAvx512<DoubleAvx512>(array, count);
+	case SimdLevel::AVX2:
+		return maxAvx2<DoubleAvx2>(array, count);
+	case SimdLevel::SSE2:
+		return maxSse2<DoubleSse2>(array, count);
+#endif
+	default:
+		return maxScalar(array, count);
+	}
+}  // end maxArraySimd
+
+int maxArray(int array[], int first, int last)
+{
+	return maxArray(static_cast<const int*>(array), first, last);
+}  // end maxArray
+
+float maxArray(float array[], int first, int last)
+{
+	return maxArray(static_cast<const float*>(array), first, last);
+}  // end maxArray
+
+double maxArray(double array[], int first, int last)
+{
+	return maxArray(static_cast<const double*>(array), first, last);
+}  // end maxArray
+
+int maxArray(const int array[], int first, int last)
+{
+	return maxArraySimd(array + first, static_cast<std::size_t>(last - first) + 1, detectSimdLevel());
+}  // end maxArray
+
+float maxArray(const float array[], int first, int last)
+{
+	return maxArraySimd(array + first, static_cast<std::size_t>(last - first) + 1, detectSimdLevel());
+}  // end maxArray
+
+double maxArray(const double array[], int first, int last)
+{
+	return maxArraySimd(array + first, static_cast<std::size_t>(last - first) + 1, detectSimdLevel());
+}  // end maxArray
+
+void maxArrayInto(int acc[], const int items[], std::size_t count)
+{
+	switch (detectSimdLevel())
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		maxIntoAvx512<IntAvx512>(acc, items, count);
+		break;
+	case SimdLevel::AVX2:
+		maxIntoAvx2<IntAvx2>(acc, items, count);
+		break;
+	case SimdLevel::SSE2:
+		maxIntoSse2<IntSse2>(acc, items, count);
+		break;
+#endif
+	default:
+		maxIntoScalar(acc, items, count);
+	}
+}  // end maxArrayInto
+
+void maxArrayInto(float acc[], const float items[], std::size_t count)
+{
+	switch (detectSimdLevel())
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		maxIntoAvx512<FloatAvx512>(acc, items, count);
+		break;
+	case SimdLevel::AVX2:
+		maxIntoAvx2<FloatAvx2>(acc, items, count);
+		break;
+	case SimdLevel::SSE2:
+		maxIntoSse2<FloatSse2>(acc, items, count);
+		break;
+#endif
+	default:
+		maxIntoScalar(acc, items, count);
+	}
+}  // end maxArrayInto
+
+void maxArrayInto(double acc[], const double items[], std::size_t count)
+{
+	switch (detectSimdLevel())
+	{
+#ifdef MAX_ARRAY_X86_
+	case SimdLevel::AVX512:
+		maxIntoAvx512<DoubleAvx512>(acc, items, count);
+		break;
+	case SimdLevel::AVX2:
+		maxIntoAvx2<DoubleAvx2>(acc, items, count);
+		break;
+	case SimdLevel::SSE2:
+		maxIntoSse2<DoubleSse2>(acc, items, count);
+		break;
+#endif
+	default:
+		maxIntoScalar(acc, items, count);
+	}
+}  // end maxArrayInto
@@ -0,0 +1,147 @@
+// Allen Lim
+
+/** Maximum of an array segment: recursive template plus SIMD kernels
+ for the arithmetic element types.
+ @file MaxArray.h */
+
+#ifndef MAX_ARRAY_
+#define MAX_ARRAY_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+
+// Instruction sets the arithmetic kernels can run on, narrowest first.
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+// Returns the widest instruction set the running CPU supports.
+// Detection runs once; later calls return the cached answer.
+SimdLevel detectSimdLevel();
+
+const char* simdLevelName(SimdLevel level);
+
+// Maximum of count (>= 1) contiguous elements using the requested
+// instruction set. A level the CPU lacks is lowered to detectSimdLevel().
+int maxArraySimd(const int array[], std::size_t count, SimdLevel level);
+float maxArraySimd(const float array[], std::size_t count, SimdLevel level);
+double maxArraySimd(const double array[], std::size_t count, SimdLevel level);
+
+// Returns the index of the largest of array[first..last] (inclusive,
+// first <= last); ties go to the leftmost. Only indices travel up the
+// recursion, so no element is copied.
+template<class ElementType>
+constexpr int maxArrayIndex(const ElementType array[], int first, int last)
+{
+	int mid = first + (last - first) / 2;
+	if (first == last)
+		return first;
+	int left = maxArrayIndex(array, first, mid);
+	int right = maxArrayIndex(array, mid + 1, last);
+	return (array[left] < array[right]) ? right : left;
+}  // end maxArrayIndex
+
+// Returns the offset from begin of the largest element in [begin, end),
+// or 0 for an empty range. Works with any forward iterator, e.g. a
+// std::vector or a string array segment, and never copies an element.
+template<class ForwardIterator>
+constexpr std::size_t maxArrayIndex(ForwardIterator begin, ForwardIterator end)
+{
+	std::size_t best = 0;
+	if (begin == end)
+		return best;
+	ForwardIterator bestIt = begin;
+	std::size_t i = 1;
+	for (ForwardIterator it = ++begin; it != end; ++it, ++i)
+	{
+		if (*bestIt < *it)
+		{
+			bestIt = it;
+			best = i;
+		}
+	}
+	return best;
+}  // end maxArrayIndex
+
+// Returns the largest of array[first..last] (inclusive, first <= last).
+// The winner is found by index and copied once, which matters for
+// heavyweight element types such as std::string. Usable in constant
+// expressions, e.g. on a constexpr int table[]: for int, float and double
+// arrays name the element type, maxArray<int>(table, 0, 2), since plain
+// maxArray(table, 0, 2) picks the runtime-only SIMD overloads below.
+template<class ElementType>
+constexpr ElementType maxArray(const ElementType array[], int first, int last)
+{
+	return array[maxArrayIndex(array, first, last)];
+}  // end maxArray
+
+// Arrays up to this size are reduced by a tree unrolled at compile time.
+const std::size_t MAX_UNROLLED_ARRAY = 64;
+
+// Reduction tree over array[First..Last], fixed at compile time. Each
+// node is a single compare-and-select on references, which compilers
+// lower to branch-free max instructions for arithmetic types.
+template<std::size_t First, std::size_t Last, class ElementType, std::size_t N>
+constexpr const ElementType& maxArrayTree(const std::array<ElementType, N>& array)
+{
+	if constexpr (First == Last)
+		return array[First];
+	else
+	{
+		constexpr std::size_t mid = First + (Last - First) / 2;
+		const ElementType& left = maxArrayTree<First, mid>(array);
+		const ElementType& right = maxArrayTree<mid + 1, Last>(array);
+		return (left < right) ? right : left;
+	}
+}  // end maxArrayTree
+
+// Returns the largest element of a fixed-size array (N >= 1). A constexpr
+// array folds to a constant; small runtime arrays get a fully unrolled
+// tree and larger ones a single loop.
+template<class ElementType, std::size_t N>
+constexpr ElementType maxArray(const std::array<ElementType, N>& array)
+{
+	static_assert(N > 0, "maxArray needs at least one element");
+	if constexpr (N <= MAX_UNROLLED_ARRAY)
+		return maxArrayTree<0, N - 1>(array);
+	else
+		return array[maxArrayIndex(array.begin(), array.end())];
+}  // end maxArray
+
+// int, float and double segments skip the recursion and run the widest
+// SIMD kernel the CPU supports. NaNs and signed zeros have no defined order.
+int maxArray(int array[], int first, int last);
+float maxArray(float array[], int first, int last);
+double maxArray(double array[], int first, int last);
+int maxArray(const int array[], int first, int last);
+float maxArray(const float array[], int first, int last);
+double maxArray(const double array[], int first, int last);
+
+// Index of the largest of array[first..last] (inclusive, first <= last),
+// found by a prefix-elimination tournament: each candidate contributes its
+// next 16 bytes as two big-endian words, and only the candidates holding
+// the largest chunk go on to the next 16 bytes. Rounds run over blocks of
+// 256 strings so they stay in cache; once a round stops eliminating, the
+// rest is a memcmp scan past the prefix the survivors are known to share.
+// Same result and leftmost tie-breaking as maxArrayIndex. It beats
+// pairwise operator< when keys diverge early; with long shared prefixes
+// both must read every key up to where it leaves the leader, so expect
+// parity there.
+int maxStringIndex(const std::string array[], int first, int last);
+
+// Sets acc[i] to the larger of acc[i] and items[i] for every i < count;
+// the building block for column-wise reductions. int, float and double
+// use the SIMD kernels.
+template<class ElementType>
+void maxArrayInto(ElementType acc[], const ElementType items[], std::size_t count)
+{
+	for (std::size_t i = 0; i < count; i++)
+		if (acc[i] < items[i])
+			acc[i] = items[i];
+}  // end maxArrayInto
+
+void maxArrayInto(int acc[], const int items[], std::size_t count);
+void maxArrayInto(float acc[], const float items[], std::size_t count);
+void maxArrayInto(double acc[], const double items[], std::size_t count);
+
+#endif
@@ -0,0 +1,63 @@
+// Allen Lim
+
+/** Fork-join maxArray that spreads large segments over a thread pool.
+ @file ParallelMaxArray.h */
+
+#ifndef PARALLEL_MAX_ARRAY_
+#define PARALLEL_MAX_ARRAY_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "MaxArray.h"
+#include "ThreadPool.h"
+
+// ParallelOptions plus the smallest part worth handing to a worker.
+struct ParallelMaxOptions : ParallelOptions
+{
+	std::size_t grainSize = std::size_t(1) << 18;
+};
+
+// Returns the largest of array[first..last] (inclusive, first <= last).
+// The segment is cut into at most threadCount parts of at least grainSize
+// elements; each part is reduced with maxArray and the partial maxima are
+// merged left to right, so ties resolve exactly as in maxArray. Takes
+// const and non-const arrays alike.
+template<class ElementType>
+ElementType parallelMaxArray(const ElementType array[], std::size_t first, std::size_t last,
+                             const ParallelMaxOptions& options = ParallelMaxOptions())
+{
+	ThreadPool& pool = ThreadPool::of(options);
+	const std::size_t count = last - first + 1;
+	const std::size_t grain = std::max<std::size_t>(options.grainSize, 1);
+	const std::size_t threads = (options.threadCount != 0) ? options.threadCount : pool.size();
+	const std::size_t parts = std::max<std::size_t>(1, std::min(threads, (count + grain - 1) / grain));
+	const std::size_t partSize = (count + parts - 1) / parts;
+
+	const ElementType* base = array + first;
+	std::vector<std::optional<ElementType>> partials(parts);
+	pool.parallelFor(0, parts, options.threadCount, [&](std::size_t part)
+	{
+		// maxArray indexes with int, so walk the part in int-sized slices.
+		const std::size_t slice = std::numeric_limits<int>::max();
+		std::size_t begin = part * partSize;
+		std::size_t end = std::min(count, begin + partSize);
+		if (begin >= end)
+			return;
+		ElementType partMax = maxArray(base + begin, 0, static_cast<int>(std::min(slice, end - begin) - 1));
+		for (begin += slice; begin < end; begin += slice)
+			partMax = std::max(partMax, maxArray(base + begin, 0, static_cast<int>(std::min(slice, end - begin) - 1)));
+		partials[part] = std::move(partMax);
+	});
+
+	ElementType result = std::move(*partials[0]);
+	for (std::size_t part = 1; part < parts; part++)
+		if (partials[part])
+			result = std::max(result, *partials[part]);
+	return result;
+}  // end parallelMaxArray
+
+#endif
@@ -0,0 +1,193 @@
+// Allen Lim
+
+/** Range-maximum index: built once over an array, then answers
+ maxArray(array, first, last) for any window in O(1).
+ @file RangeMaxIndex.h */
+
+#ifndef RANGE_MAX_INDEX_
+#define RANGE_MAX_INDEX_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Position of the highest set bit of x (x > 0).
+inline int floorLog2(std::uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 31 - __builtin_clz(x);
+#else
+	int result = 0;
+	while (x >>= 1)
+		result++;
+	return result;
+#endif
+}  // end floorLog2
+
+// Position of the lowest set bit of x (x > 0).
+inline int lowestBit(std::uint32_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(x);
+#else
+	int result = 0;
+	while ((x & 1u) == 0)
+	{
+		x >>= 1;
+		result++;
+	}
+	return result;
+#endif
+}  // end lowestBit
+
+template<class ElementType>
+class RangeMaxIndex
+{
+public:
+	// Fast keeps a full sparse table: about 4 * log2(n) bytes per element.
+	// Compact splits the array into 32-element blocks, keeps one bit mask
+	// per element for in-block queries and a sparse table over block
+	// maxima only: a little over 4 bytes per element. Both answer in O(1).
+	enum class Mode { Fast, Compact };
+
+	static const int BLOCK_SIZE = 32;
+
+	// Indexes array[0..count-1]. The array is not copied and must outlive
+	// the index and stay unchanged; rebuild after modifying it.
+	RangeMaxIndex(const ElementType array[], int count, Mode mode = Mode::Fast);
+
+	// Index of the largest of array[first..last] (inclusive,
+	// 0 <= first <= last < count); ties go to the leftmost, as in maxArray.
+	int maxIndex(int first, int last) const;
+
+	// The largest of array[first..last]; equals maxArray(array, first, last).
+	const ElementType& maxValue(int first, int last) const;
+
+	int size() const;
+	Mode mode() const;
+private:
+	const ElementType* items;
+	int itemCount;
+	Mode indexMode;
+	// sparse[k][i] is the leftmost maximum of the 2^k entries starting at
+	// i: over elements in Fast mode, over blocks in Compact mode.
+	std::vector<std::vector<int>> sparse;
+	// Compact mode only: blockMax[b] is the leftmost maximum of block b,
+	// and bit j of stackMask[i] is set when element (block start + j) is
+	// no smaller than everything after it up to i.
+	std::vector<int> blockMax;
+	std::vector<std::uint32_t> stackMask;
+
+	int better(int left, int right) const;
+	void buildSparse(const std::vector<int>& level0);
+	int querySparse(int first, int last) const;
+	int queryBlock(int first, int last) const;
+};
+
+template<class ElementType>
+RangeMaxIndex<ElementType>::RangeMaxIndex(const ElementType array[], int count, Mode mode)
+	: items(array), itemCount(count), indexMode(mode)
+{
+	if (count <= 0)
+		return;
+	if (mode == Mode::Fast)
+	{
+		std::vector<int> level0(count);
+		for (int i = 0; i < count; i++)
+			level0[i] = i;
+		buildSparse(level0);
+		return;
+	}
+
+	stackMask.resize(count);
+	blockMax.resize((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+	for (int start = 0; start < count; start += BLOCK_SIZE)
+	{
+		// Monotonic stack of in-block offsets, kept as a bit set.
+		std::uint32_t mask = 0;
+		int end = (count - start < BLOCK_SIZE) ? count : start + BLOCK_SIZE;
+		for (int i = start; i < end; i++)
+		{
+			while (mask != 0 && items[start + floorLog2(mask)] < items[i])
+				mask &= ~(std::uint32_t(1) << floorLog2(mask));
+			mask |= std::uint32_t(1) << (i - start);
+			stackMask[i] = mask;
+		}
+		blockMax[start / BLOCK_SIZE] = start + lowestBit(mask);
+	}
+	buildSparse(blockMax);
+}  // end constructor
+
+template<class ElementType>
+int RangeMaxIndex<ElementType>::better(int left, int right) const
+{
+	return (items[left] < items[right]) ? right : left;
+}  // end better
+
+template<class ElementType>
+void RangeMaxIndex<ElementType>::buildSparse(const std::vector<int>& level0)
+{
+	sparse.clear();
+	sparse.push_back(level0);
+	const int n = static_cast<int>(level0.size());
+	for (int k = 1; (1 << k) <= n; k++)
+	{
+		const std::vector<int>& prev = sparse[k - 1];
+		std::vector<int> next(n - (1 << k) + 1);
+		for (int i = 0; i < static_cast<int>(next.size()); i++)
+			next[i] = better(prev[i], prev[i + (1 << (k - 1))]);
+		sparse.push_back(std::move(next));
+	}
+}  // end buildSparse
+
+template<class ElementType>
+int RangeMaxIndex<ElementType>::querySparse(int first, int last) const
+{
+	int k = floorLog2(static_cast<std::uint32_t>(last - first + 1));
+	return better(sparse[k][first], sparse[k][last - (1 << k) + 1]);
+}  // end querySparse
+
+template<class ElementType>
+int RangeMaxIndex<ElementType>::queryBlock(int first, int last) const
+{
+	int start = first - first % BLOCK_SIZE;
+	std::uint32_t mask = stackMask[last] & (~std::uint32_t(0) << (first - start));
+	return start + lowestBit(mask);
+}  // end queryBlock
+
+template<class ElementType>
+int RangeMaxIndex<ElementType>::maxIndex(int first, int last) const
+{
+	if (indexMode == Mode::Fast)
+		return querySparse(first, last);
+
+	int firstBlock = first / BLOCK_SIZE;
+	int lastBlock = last / BLOCK_SIZE;
+	if (firstBlock == lastBlock)
+		return queryBlock(first, last);
+	int result = queryBlock(first, firstBlock * BLOCK_SIZE + BLOCK_SIZE - 1);
+	if (lastBlock - firstBlock > 1)
+		result = better(result, querySparse(firstBlock + 1, lastBlock - 1));
+	return better(result, queryBlock(lastBlock * BLOCK_SIZE, last));
+}  // end maxIndex
+
+template<class ElementType>
+const ElementType& RangeMaxIndex<ElementType>::maxValue(int first, int last) const
+{
+	return items[maxIndex(first, last)];
+}  // end maxValue
+
+template<class ElementType>
+int RangeMaxIndex<ElementType>::size() const
+{
+	return itemCount;
+}  // end size
+
+template<class ElementType>
+typename RangeMaxIndex<ElementType>::Mode RangeMaxIndex<ElementType>::mode() const
+{
+	return indexMode;
+}  // end mode
+
+#endif
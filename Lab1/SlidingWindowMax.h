@@ -0,0 +1,141 @@
+// Allen Lim
+
+/** Running maximum of the last W samples of a stream, maintained with a
+ monotonic deque so each push, pop and query is amortized O(1).
+ @file SlidingWindowMax.h */
+
+#ifndef SLIDING_WINDOW_MAX_
+#define SLIDING_WINDOW_MAX_
+
+#include <cstddef>
+#include <vector>
+
+template<class ElementType>
+class SlidingWindowMax
+{
+private:
+	struct Entry
+	{
+		std::size_t sequence;  // position of the sample in the stream
+		ElementType item;
+	};
+	// Ring buffer of candidates: sequences increase and items never
+	// increase from front to back, so the front is the window maximum.
+	// A window holds at most capacity candidates, so it never reallocates.
+	std::vector<Entry> candidates;
+	std::size_t front;
+	std::size_t candidateCount;
+	std::size_t oldest;  // sequence of the oldest sample in the window
+	std::size_t next;    // sequence the next pushed sample gets
+
+	std::size_t slot(std::size_t offset) const;
+public:
+	// window >= 1 is the number of most recent samples max() covers.
+	explicit SlidingWindowMax(std::size_t window);
+
+	bool isEmpty() const;
+	std::size_t size() const;
+	std::size_t window() const;
+
+	// Adds a sample; if the window was full the oldest sample drops out.
+	void push(const ElementType& newItem);
+	// Drops the oldest sample; returns false if the window was empty.
+	bool pop();
+	// Largest sample in the window. Precondition: !isEmpty().
+	const ElementType& max() const;
+	void clear();
+};
+
+template<class ElementType>
+SlidingWindowMax<ElementType>::SlidingWindowMax(std::size_t window)
+	: candidates(window == 0 ? 1 : window), front(0), candidateCount(0), oldest(0), next(0)
+{
+}
+
+template<class ElementType>
+std::size_t SlidingWindowMax<ElementType>::slot(std::size_t offset) const
+{
+	std::size_t index = front + offset;
+	return (index >= candidates.size()) ? index - candidates.size() : index;
+}  // end slot
+
+template<class ElementType>
+bool SlidingWindowMax<ElementType>::isEmpty() const
+{
+	return next == oldest;
+}
+
+template<class ElementType>
+std::size_t SlidingWindowMax<ElementType>::size() const
+{
+	return next - oldest;
+}
+
+template<class ElementType>
+std::size_t SlidingWindowMax<ElementType>::window() const
+{
+	return candidates.size();
+}
+
+template<class ElementType>
+void SlidingWindowMax<ElementType>::push(const ElementType& newItem)
+{
+	if (size() == candidates.size())
+		pop();
+	// Samples smaller than the new one can never be the maximum again.
+	while (candidateCount > 0 && candidates[slot(candidateCount - 1)].item < newItem)
+		candidateCount--;
+	Entry& entry = candidates[slot(candidateCount)];
+	entry.sequence = next++;
+	entry.item = newItem;
+	candidateCount++;
+}  // end push
+
+template<class ElementType>
+bool SlidingWindowMax<ElementType>::pop()
+{
+	if (isEmpty())
+		return false;
+	if (candidates[front].sequence == oldest)
+	{
+		front = slot(1);
+		candidateCount--;
+	}
+	oldest++;
+	return true;
+}  // end pop
+
+template<class ElementType>
+const ElementType& SlidingWindowMax<ElementType>::max() const
+{
+	return candidates[front].item;
+}  // end max
+
+template<class ElementType>
+void SlidingWindowMax<ElementType>::clear()
+{
+	front = 0;
+	candidateCount = 0;
+	oldest = next;
+}  // end clear
+
+// Returns the maximum of every window of the given width over
+// array[first..last], in order: element i is
+// maxArray(array, first + i, first + i + window - 1).
+// Precondition: 1 <= window <= last - first + 1.
+template<class ElementType>
+std::vector<ElementType> slidingMaxArray(const ElementType array[], int first, int last, int window)
+{
+	std::vector<ElementType> maxima;
+	maxima.reserve(last - first + 2 - window);
+	SlidingWindowMax<ElementType> tracker(window);
+	for (int i = first; i <= last; i++)
+	{
+		tracker.push(array[i]);
+		if (i - first + 1 >= window)
+			maxima.push_back(tracker.max());
+	}
+	return maxima;
+}  // end slidingMaxArray
+
+#endif
@@ -0,0 +1,138 @@
+// Allen Lim
+
+/** Prefix-elimination tournament for the maximum of a std::string array.
+ @file StringMax.cpp */
+
+#include "MaxArray.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+// The next up-to-16 bytes of a string from some offset, packed so that
+// comparing two Chunks orders them like std::string's operator<.
+struct Chunk
+{
+	std::uint64_t high;  // bytes 0..7 as a big-endian number, zero-padded
+	std::uint64_t low;   // bytes 8..15, likewise
+	std::size_t bytes;   // real bytes in the chunk, 0..16
+};
+
+// Loads count (<= 8) bytes as a big-endian number, zero-padded.
+inline std::uint64_t loadWord(const char* p, std::size_t count)
+{
+	std::uint64_t word = 0;
+	if (count == 8)
+		std::memcpy(&word, p, 8);
+	else
+		std::memcpy(&word, p, count);
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	return __builtin_bswap64(word);
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return word;
+#else
+	unsigned char buffer[8] = {};
+	std::memcpy(buffer, p, count);
+	word = 0;
+	for (int i = 0; i < 8; i++)
+		word = (word << 8) | buffer[i];
+	return word;
+#endif
+}  // end loadWord
+
+inline Chunk chunkAt(const std::string& s, std::size_t offset)
+{
+	Chunk chunk;
+	chunk.bytes = std::min<std::size_t>(s.size() - offset, 16);
+	const char* p = s.data() + offset;
+	chunk.high = loadWord(p, std::min<std::size_t>(chunk.bytes, 8));
+	chunk.low = (chunk.bytes > 8) ? loadWord(p + 8, chunk.bytes - 8) : 0;
+	return chunk;
+}  // end chunkAt
+
+// With equal words the string with more real bytes is longer and, the
+// shorter one being its prefix, larger.
+inline bool chunkLess(const Chunk& a, const Chunk& b)
+{
+	if (a.high != b.high)
+		return a.high < b.high;
+	if (a.low != b.low)
+		return a.low < b.low;
+	return a.bytes < b.bytes;
+}  // end chunkLess
+
+// Runs the tournament over the candidates in survivors (in index order)
+// and returns the winning index.
+int tournament(const std::string array[], std::vector<int>& survivors)
+{
+	for (std::size_t offset = 0; ; offset += 16)
+	{
+		// Keep only the candidates whose chunk at offset is the largest,
+		// in their original order so ties still go to the leftmost.
+		const std::size_t entrants = survivors.size();
+		Chunk best = chunkAt(array[survivors[0]], offset);
+		std::size_t kept = 1;
+		for (std::size_t i = 1; i < entrants; i++)
+		{
+			Chunk chunk = chunkAt(array[survivors[i]], offset);
+			if (chunkLess(best, chunk))
+			{
+				best = chunk;
+				kept = 0;
+				survivors[kept++] = survivors[i];
+			}
+			else if (!chunkLess(chunk, best))
+				survivors[kept++] = survivors[i];
+		}
+		survivors.resize(kept);
+		// A lone survivor has won; survivors that all end inside this
+		// chunk are equal strings.
+		if (kept == 1 || best.bytes < 16)
+			return survivors[0];
+
+		// A round that removed fewer than half the entrants means a long
+		// shared prefix; the rest is cheaper as one memcmp-based scan that
+		// starts after the bytes every survivor is known to share.
+		if (kept * 2 > entrants)
+		{
+			const std::size_t shared = offset + 16;
+			int winner = survivors[0];
+			for (std::size_t i = 1; i < kept; i++)
+			{
+				const std::string& leader = array[winner];
+				const std::string& candidate = array[survivors[i]];
+				std::size_t common = std::min(leader.size(), candidate.size()) - shared;
+				int order = std::memcmp(leader.data() + shared, candidate.data() + shared, common);
+				if (order < 0 || (order == 0 && leader.size() < candidate.size()))
+					winner = survivors[i];
+			}
+			return winner;
+		}
+	}
+}  // end tournament
+
+}  // end namespace
+
+int maxStringIndex(const std::string array[], int first, int last)
+{
+	// Tournaments run over blocks small enough that the strings stay in
+	// cache across rounds; block winners are then compared directly.
+	const int blockSize = 256;
+	std::vector<int> survivors;
+	survivors.reserve(blockSize);
+	int winner = first;
+	for (int start = first; start <= last; start += blockSize)
+	{
+		int end = (last - start < blockSize) ? last : start + blockSize - 1;
+		survivors.clear();
+		for (int i = start; i <= end; i++)
+			survivors.push_back(i);
+		int blockWinner = tournament(array, survivors);
+		if (array[winner] < array[blockWinner])
+			winner = blockWinner;
+	}
+	return winner;
+}  // end maxStringIndex
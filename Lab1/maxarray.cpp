@@ -2,28 +2,74 @@
 
 #include <iostream>
 #include <string>
+#include <exception>
+#include <iomanip>
+#include <limits>
 #include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+#include "MaxArray.h"
+#include "ParallelMaxArray.h"
+#include "ArrayStats.h"
+#include "MappedMaxArray.h"
+#include "MatrixMax.h"
+#include "RangeMaxIndex.h"
+#include "SlidingWindowMax.h"
 
-template <class ElementType>
-ElementType maxArray(ElementType array[], int first, int last);
-
-int main()
+int main(int argc, char* argv[])
 {
+   // maxarray_exe int32|float64 <file>: max of a raw binary dump
+   if (argc == 3)
+   {
+      std::string type(argv[1]);
+      try
+      {
+         if (type == "int32")
+            std::cout << maxArrayFile<int>(argv[2]) << "\n";
+         else if (type == "float64")
+            std::cout << std::setprecision(std::numeric_limits<double>::max_digits10)
+                      << maxArrayFile<double>(argv[2]) << "\n";
+         else
+         {
+            std::cerr << "usage: " << argv[0] << " [int32|float64 <file>]\n";
+            return 1;
+         }
+      }
+      catch (const std::exception& e)
+      {
+         std::cerr << e.what() << "\n";
+         return 1;
+      }
+      return 0;
+   }
    double x[] = {1.1, 6.6, 3.3, 4.4, 2.2};
    std::cout << "max of (1.1, 6.6, 3.3, 4.4, 2.2): " << maxArray(x, 0, (sizeof(x) / sizeof(x[0])) - 1) << "\n";
    int num[] = {1, 2, 5, 4};
    std::cout << "max of (1, 2, 5, 4): " << maxArray(num, 0, (sizeof(num) / sizeof(num[0])) - 1) << "\n";
    std::string s[] = {"zz", "aa", "bb", "cc"};
    std::cout << "max of (zz, aa, bb, cc): " << maxArray(s, 0, (sizeof(s) / sizeof(s[0])) - 1) << "\n";
+   constexpr std::array<int, 6> table = {{3, 9, 4, 1, 8, 2}};
+   constexpr int tableMax = maxArray(table);
+   std::cout << "compile-time max of (3, 9, 4, 1, 8, 2): " << tableMax << "\n";
+   constexpr int sample[] = {3, 9, 4};
+   constexpr int sampleMax = maxArray<int>(sample, 0, 2);
+   std::cout << "compile-time max of (3, 9, 4): " << sampleMax << "\n";
+   std::cout << "index of max of (zz, aa, bb, cc): " << maxArrayIndex(s, 0, 3) << "\n";
+   RangeMaxIndex<double> ranges(x, 5);
+   std::cout << "max of x[2..4] via range index: " << ranges.maxValue(2, 4) << "\n";
+   std::vector<double> windows = slidingMaxArray(x, 0, 4, 3);
+   std::cout << "max of each 3-wide window of x: " << windows[0] << " " << windows[1] << " " << windows[2] << "\n";
+   int grid[] = {1, 8, 3,
+                 7, 2, 9};
+   int columns[3];
+   columnMaxArray(grid, 2, 3, 3, columns);
+   std::cout << "column maxima of {{1, 8, 3}, {7, 2, 9}}: " << columns[0] << " " << columns[1] << " " << columns[2] << "\n";
+   ArrayStats<int> stats = reduceArray<StatMin | StatArgMax | StatTopK>(num, 0, 3, 2);
+   std::cout << "min, argmax, top 2 of (1, 2, 5, 4): " << stats.min << ", " << stats.argMax
+             << ", " << stats.topK[0] << " " << stats.topK[1] << "\n";
+   std::vector<int> big(1000000);
+   std::iota(big.begin(), big.end(), 0);
+   std::cout << "parallel max of (0 .. 999999): " << parallelMaxArray(big.data(), 0, big.size() - 1) << "\n";
 	return 0;
 }
-
-template<class ElementType>
-ElementType maxArray(ElementType array[], int first, int last)
-{
-	int mid = (first + last) / 2;
-	if (first == last)
-		return array[first];
-	else
-		return std::max(maxArray(array, first, mid), maxArray(array, mid + 1, last));
-}
@@ -0,0 +1,188 @@
+// Allen Lim
+
+/** Benchmarks maxArray and its alternative kernels across element
+ types, array sizes and data distributions.
+
+ usage: maxarray_bench [--max-size N] [--min-time SECONDS] [--json]
+
+ Sizes run in powers of ten from 1e2 up to --max-size (default 1e7;
+ 1e9 doubles need 8 GB). --json prints one record per measurement for
+ regression tracking instead of the table.
+ @file maxarray_bench.cpp */
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Bench.h"
+#include "MaxArray.h"
+#include "ParallelMaxArray.h"
+
+struct BenchResult
+{
+	std::string type;
+	std::size_t size;
+	std::string distribution;
+	std::string strategy;
+	double nsPerElement;
+	double gbPerSecond;
+};
+
+// Keeps results observable so the compiler cannot drop the timed calls.
+volatile std::size_t benchSink;
+
+template<class ElementType>
+ElementType makeElement(std::size_t value);
+
+template<>
+int makeElement<int>(std::size_t value)
+{
+	return static_cast<int>(value);
+}
+
+template<>
+double makeElement<double>(std::size_t value)
+{
+	return static_cast<double>(value) * 0.5;
+}
+
+template<>
+std::string makeElement<std::string>(std::size_t value)
+{
+	char buffer[32];
+	std::snprintf(buffer, sizeof(buffer), "key-%012zu", value);
+	return buffer;
+}
+
+template<class ElementType>
+std::vector<ElementType> makeData(std::size_t size, const std::string& distribution)
+{
+	std::vector<ElementType> data(size);
+	std::mt19937_64 generator(size);
+	for (std::size_t i = 0; i < size; i++)
+	{
+		std::size_t value = i;
+		if (distribution == "reversed")
+			value = size - i;
+		else if (distribution == "random")
+			value = generator() % size;
+		data[i] = makeElement<ElementType>(value);
+	}
+	return data;
+}  // end makeData
+
+// A named way of reducing n elements; returns a hash of the result.
+template<class ElementType>
+using Strategy = std::pair<std::string, std::function<std::size_t(ElementType*, std::size_t)>>;
+
+template<class ElementType>
+void addSimdLevels(std::vector<Strategy<ElementType>>& strategies)
+{
+	for (int level = 0; level <= static_cast<int>(detectSimdLevel()); level++)
+	{
+		SimdLevel simd = static_cast<SimdLevel>(level);
+		strategies.push_back(Strategy<ElementType>(std::string("simd-") + simdLevelName(simd),
+			[simd](ElementType* a, std::size_t n) { return std::hash<ElementType>()(maxArraySimd(a, n, simd)); }));
+	}
+}  // end addSimdLevels
+
+// Only int, float and double have SIMD kernels; strings get the
+// prefix-elimination tournament instead.
+void addSimdStrategies(std::vector<Strategy<std::string>>& strategies)
+{
+	strategies.push_back(Strategy<std::string>("tournament", [](std::string* a, std::size_t n)
+		{ return static_cast<std::size_t>(maxStringIndex(a, 0, static_cast<int>(n) - 1)); }));
+}
+
+void addSimdStrategies(std::vector<Strategy<int>>& strategies)
+{
+	addSimdLevels(strategies);
+}
+
+void addSimdStrategies(std::vector<Strategy<double>>& strategies)
+{
+	addSimdLevels(strategies);
+}
+
+template<class ElementType>
+void benchType(const std::string& typeName, std::size_t maxSize, double minSeconds,
+               std::vector<BenchResult>& results)
+{
+	std::vector<Strategy<ElementType>> strategies;
+	// The explicit template argument selects the recursive template even
+	// for the types that have SIMD overloads.
+	strategies.push_back(Strategy<ElementType>("recursive", [](ElementType* a, std::size_t n)
+		{ return std::hash<ElementType>()(maxArray<ElementType>(a, 0, static_cast<int>(n) - 1)); }));
+	strategies.push_back(Strategy<ElementType>("index", [](ElementType* a, std::size_t n)
+		{ return maxArrayIndex(a, a + n); }));
+	strategies.push_back(Strategy<ElementType>("parallel", [](ElementType* a, std::size_t n)
+		{ return std::hash<ElementType>()(parallelMaxArray(a, 0, n - 1)); }));
+	addSimdStrategies(strategies);
+
+	const char* distributions[] = { "sorted", "reversed", "random" };
+	for (std::size_t size = 100; size <= maxSize; size *= 10)
+	{
+		for (const char* distribution : distributions)
+		{
+			std::vector<ElementType> data = makeData<ElementType>(size, distribution);
+			for (const Strategy<ElementType>& strategy : strategies)
+			{
+				// maxArray and maxArrayIndex index with int.
+				if (strategy.first != "parallel" && size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+					continue;
+				double seconds = bestTime([&] { benchSink = benchSink + strategy.second(data.data(), size); }, 3, minSeconds);
+				BenchResult result;
+				result.type = typeName;
+				result.size = size;
+				result.distribution = distribution;
+				result.strategy = strategy.first;
+				result.nsPerElement = seconds * 1e9 / size;
+				result.gbPerSecond = size * sizeof(ElementType) / seconds / 1e9;
+				results.push_back(result);
+			}
+		}
+	}
+}  // end benchType
+
+int main(int argc, char* argv[])
+{
+	std::size_t maxSize = 10000000;
+	double minSeconds = 0.2;
+	bool json = false;
+	if (!BenchArgs().option("--max-size", "N", maxSize).option("--min-time", "SECONDS", minSeconds).flag("--json", json).parse(argc, argv))
+		return 1;
+
+	std::vector<BenchResult> results;
+	benchType<int>("int", maxSize, minSeconds, results);
+	benchType<double>("double", maxSize, minSeconds, results);
+	// Strings are 32+ bytes each plus their heap buffers; stop at 1e7.
+	benchType<std::string>("string", std::min<std::size_t>(maxSize, 10000000), minSeconds, results);
+
+	if (json)
+	{
+		std::printf("{\"simd\": \"%s\", \"threads\": %u, \"results\": [\n",
+		            simdLevelName(detectSimdLevel()), ThreadPool::shared().size());
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			const BenchResult& r = results[i];
+			std::printf("  {\"type\": \"%s\", \"size\": %zu, \"distribution\": \"%s\", \"strategy\": \"%s\", "
+			            "\"ns_per_element\": %.4f, \"gb_per_s\": %.3f}%s\n",
+			            r.type.c_str(), r.size, r.distribution.c_str(), r.strategy.c_str(),
+			            r.nsPerElement, r.gbPerSecond, (i + 1 < results.size()) ? "," : "");
+		}
+		std::printf("]}\n");
+	}
+	else
+	{
+		std::printf("simd: %s, threads: %u\n", simdLevelName(detectSimdLevel()), ThreadPool::shared().size());
+		std::printf("%-7s %12s %-9s %-13s %10s %9s\n", "type", "size", "dist", "strategy", "ns/elem", "GB/s");
+		for (const BenchResult& r : results)
+			std::printf("%-7s %12zu %-9s %-13s %10.4f %9.3f\n", r.type.c_str(), r.size,
+			            r.distribution.c_str(), r.strategy.c_str(), r.nsPerElement, r.gbPerSecond);
+	}
+	return 0;
+}
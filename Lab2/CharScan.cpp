@@ -0,0 +1,152 @@
+// Allen Lim
+
+/** @file CharScan.cpp */
+
+#include "CharScan.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CHAR_SCAN_SSE2_
+#endif
+
+namespace
+{
+
+// Index of the lowest / highest set bit of a nonzero 16-bit mask.
+inline int lowestBit(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(mask);
+#else
+	int i = 0;
+	while ((mask & 1u) == 0)
+	{
+		mask >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+inline int highestBit(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 31 - __builtin_clz(mask);
+#else
+	int i = 31;
+	while ((mask & (1u << i)) == 0)
+		i--;
+	return i;
+#endif
+}
+
+#ifdef CHAR_SCAN_SSE2_
+// Bit i set when items[i] == ch, for the 16 bytes at items.
+inline unsigned matchMask(const char* items, __m128i needle)
+{
+	__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items));
+	return static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+}
+#endif
+
+}  // end namespace
+
+CharSet::CharSet(const char* chars, int count) : smallCount(0)
+{
+	for (int b = 0; b < 256; b++)
+		members[b] = false;
+	for (int i = 0; i < count; i++)
+	{
+		unsigned char c = static_cast<unsigned char>(chars[i]);
+		if (members[c])
+			continue;
+		members[c] = true;
+		if (smallCount >= 0 && smallCount < 8)
+			small[smallCount++] = chars[i];
+		else
+			smallCount = -1;
+	}
+}
+
+const char* scanFirst(const char* items, int count, char ch)
+{
+	// The C library's memchr is already vectorized.
+	return static_cast<const char*>(std::memchr(items, ch, count));
+}
+
+const char* scanLast(const char* items, int count, char ch)
+{
+	int i = count;
+#ifdef CHAR_SCAN_SSE2_
+	const __m128i needle = _mm_set1_epi8(ch);
+	for (; i >= 16; i -= 16)
+	{
+		unsigned mask = matchMask(items + i - 16, needle);
+		if (mask != 0)
+			return items + i - 16 + highestBit(mask);
+	}
+#endif
+	while (i > 0)
+		if (items[--i] == ch)
+			return items + i;
+	return nullptr;
+}
+
+int scanCount(const char* items, int count, char ch)
+{
+	int found = 0;
+	int i = 0;
+#ifdef CHAR_SCAN_SSE2_
+	// Each matching byte compares to 0xff, i.e. -1: subtracting the compare
+	// results counts matches per byte lane. A lane holds at most 255, so
+	// flush the lanes into found every 255 chunks with a horizontal sum.
+	const __m128i needle = _mm_set1_epi8(ch);
+	const __m128i zero = _mm_setzero_si128();
+	while (i + 16 <= count)
+	{
+		__m128i lanes = zero;
+		int chunks = (count - i) / 16;
+		if (chunks > 255)
+			chunks = 255;
+		for (int c = 0; c < chunks; c++, i += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+			lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(chunk, needle));
+		}
+		__m128i sums = _mm_sad_epu8(lanes, zero);
+		found += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sums, sums));
+	}
+#endif
+	for (; i < count; i++)
+		found += (items[i] == ch);
+	return found;
+}
+
+const char* scanFirstOf(const char* items, int count, const CharSet& set)
+{
+	int i = 0;
+#ifdef CHAR_SCAN_SSE2_
+	// Up to 8 members: OR together one byte compare per member.
+	if (set.isSmall() && set.size() > 0)
+	{
+		__m128i needles[8];
+		for (int k = 0; k < set.size(); k++)
+			needles[k] = _mm_set1_epi8(set.member(k));
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(items + i));
+			__m128i hits = _mm_cmpeq_epi8(chunk, needles[0]);
+			for (int k = 1; k < set.size(); k++)
+				hits = _mm_or_si128(hits, _mm_cmpeq_epi8(chunk, needles[k]));
+			unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+			if (mask != 0)
+				return items + i + lowestBit(mask);
+		}
+	}
+#endif
+	for (; i < count; i++)
+		if (set.contains(items[i]))
+			return items + i;
+	return nullptr;
+}
@@ -0,0 +1,34 @@
+// Allen Lim
+
+/** memchr-style character scanning kernels over a contiguous run of
+ characters, used by LinkedChar on each block. On x86-64 they compare
+ 16 bytes per SSE2 instruction; elsewhere they fall back to byte loops.
+ @file CharScan.h */
+
+#ifndef CHAR_SCAN_
+#define CHAR_SCAN_
+
+// A set of characters for scanFirstOf, built once per query.
+class CharSet
+{
+private:
+	bool members[256];
+	char small[8];     // the members, if there are at most 8 of them
+	int smallCount;    // -1 once the set outgrows small
+public:
+	explicit CharSet(const char* chars, int count);
+	bool contains(char ch) const { return members[static_cast<unsigned char>(ch)]; }
+	bool isSmall() const { return smallCount >= 0; }
+	int size() const { return smallCount; }
+	char member(int i) const { return small[i]; }
+};
+
+// First / last occurrence of ch in items[0..count), or nullptr.
+const char* scanFirst(const char* items, int count, char ch);
+const char* scanLast(const char* items, int count, char ch);
+// Number of occurrences of ch in items[0..count).
+int scanCount(const char* items, int count, char ch);
+// First character of items[0..count) that is in set, or nullptr.
+const char* scanFirstOf(const char* items, int count, const CharSet& set);
+
+#endif
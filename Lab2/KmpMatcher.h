@@ -0,0 +1,84 @@
+// Allen Lim
+
+/** KmpMatcher: Knuth-Morris-Pratt matching of one pattern over text fed
+ in contiguous runs, such as the blocks of a LinkedChar. The text is read
+ once and never re-scanned, so a search is O(n + m) even on inputs like
+ "aaa...ab".
+ @file KmpMatcher.h */
+
+#ifndef KMP_MATCHER_
+#define KMP_MATCHER_
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+class KmpMatcher
+{
+private:
+	std::string pattern;
+	// failure[i]: length of the longest proper border of pattern[0..i].
+	std::vector<int> failure;
+public:
+	// Precondition: apattern is not empty.
+	explicit KmpMatcher(std::string apattern);
+
+	int length() const;
+
+	// Reads items[0..count) on from state matched (how many pattern
+	// characters the text read so far ends with), updating matched. For
+	// each (possibly overlapping) occurrence ending in the run, calls
+	// onMatch(end) with the index in items of its last character; onMatch
+	// returns false to stop. Returns false if onMatch stopped the scan.
+	template<class OnMatch>
+	bool step(const char* items, int count, int& matched, OnMatch&& onMatch) const;
+};
+
+inline KmpMatcher::KmpMatcher(std::string apattern) : pattern(std::move(apattern)), failure(pattern.size(), 0)
+{
+	const int m = length();
+	for (int i = 1, k = 0; i < m; i++)
+	{
+		while (k > 0 && pattern[i] != pattern[k])
+			k = failure[k - 1];
+		if (pattern[i] == pattern[k])
+			k++;
+		failure[i] = k;
+	}
+}
+
+inline int KmpMatcher::length() const
+{
+	return static_cast<int>(pattern.size());
+}
+
+template<class OnMatch>
+bool KmpMatcher::step(const char* items, int count, int& matched, OnMatch&& onMatch) const
+{
+	const int m = length();
+	for (int i = 0; i < count; i++)
+	{
+		if (matched == 0)
+		{
+			// Nothing matched yet: jump straight to the next candidate start.
+			const void* next = std::memchr(items + i, pattern[0], count - i);
+			if (next == nullptr)
+				break;
+			i = static_cast<int>(static_cast<const char*>(next) - items);
+		}
+		while (matched > 0 && items[i] != pattern[matched])
+			matched = failure[matched - 1];
+		if (items[i] == pattern[matched])
+			matched++;
+		if (matched == m)
+		{
+			matched = failure[m - 1];
+			if (!onMatch(i))
+				return false;
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,416 @@
+// Allen Lim
+
+/** @file LinkedChar.cpp */
+
+#include "LinkedChar.h"
+#include "CharScan.h"
+#include "KmpMatcher.h"
+#include "SuffixIndex.h"
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Starts loading the block after curr while curr is being scanned, so
+// long scans wait on memory bandwidth rather than on each next pointer.
+static inline void prefetchNext(const Node* curr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(curr->getNext());
+#else
+	(void)curr;
+#endif
+}
+
+static const std::uint64_t HASH_MODULUS = (std::uint64_t(1) << 61) - 1;
+static const std::uint64_t HASH_BASE = 0x1f3a5c7e9b2d4f61ull % HASH_MODULUS;
+
+// a * b mod 2^61 - 1, for a, b < 2^61 - 1.
+static inline std::uint64_t hashMultiply(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	std::uint64_t folded = (static_cast<std::uint64_t>(product) & HASH_MODULUS) + static_cast<std::uint64_t>(product >> 61);
+#else
+	// Split into 31- and 30-bit halves so no partial product overflows.
+	const std::uint64_t mask30 = (std::uint64_t(1) << 30) - 1;
+	const std::uint64_t mask31 = (std::uint64_t(1) << 31) - 1;
+	const std::uint64_t aHigh = a >> 31, aLow = a & mask31;
+	const std::uint64_t bHigh = b >> 31, bLow = b & mask31;
+	const std::uint64_t middle = aLow * bHigh + aHigh * bLow;
+	std::uint64_t folded = aHigh * bHigh * 2 + (middle >> 30) + ((middle & mask30) << 31) + aLow * bLow;
+	folded = (folded & HASH_MODULUS) + (folded >> 61);
+#endif
+	return (folded >= HASH_MODULUS) ? folded - HASH_MODULUS : folded;
+}
+
+static inline std::uint64_t hashAdd(std::uint64_t a, std::uint64_t b)
+{
+	std::uint64_t sum = a + b;
+	return (sum >= HASH_MODULUS) ? sum - HASH_MODULUS : sum;
+}
+
+// HASH_BASE^exponent mod 2^61 - 1.
+static std::uint64_t hashBasePower(int exponent)
+{
+	std::uint64_t result = 1;
+	std::uint64_t square = HASH_BASE;
+	for (; exponent > 0; exponent >>= 1)
+	{
+		if (exponent & 1)
+			result = hashMultiply(result, square);
+		square = hashMultiply(square, square);
+	}
+	return result;
+}
+
+LinkedChar::LinkedChar()
+{
+	head = nullptr;
+	tail = nullptr;
+	itemCount = 0;
+	hashValue = 0;
+	hashPower = 1;
+}
+
+LinkedChar::LinkedChar(std::string_view s)
+{
+	head = nullptr;
+	tail = nullptr;
+	itemCount = 0;
+	hashValue = 0;
+	hashPower = 1;
+	addItems(s.data(), static_cast<int>(s.length()));
+}
+
+LinkedChar::LinkedChar(std::istream& in)
+{
+	head = nullptr;
+	tail = nullptr;
+	itemCount = 0;
+	hashValue = 0;
+	hashPower = 1;
+	char buffer[1 << 16];
+	while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+		addItems(buffer, static_cast<int>(in.gcount()));
+}
+
+LinkedChar::LinkedChar(const LinkedChar& lc) : LinkedChar()
+{
+	append(lc);
+	if (lc.isIndexed())
+		buildIndex();
+}
+
+LinkedChar::LinkedChar(LinkedChar&& lc) noexcept
+	: head(lc.head), tail(lc.tail), itemCount(lc.itemCount), pool(std::move(lc.pool)),
+	  suffixIndex(std::move(lc.suffixIndex)), hashValue(lc.hashValue), hashPower(lc.hashPower)
+{
+	lc.head = nullptr;
+	lc.tail = nullptr;
+	lc.itemCount = 0;
+	lc.hashValue = 0;
+	lc.hashPower = 1;
+}
+
+LinkedChar& LinkedChar::operator=(const LinkedChar& lc)
+{
+	if (&lc != this)
+	{
+		LinkedChar copy(lc);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+LinkedChar& LinkedChar::operator=(LinkedChar&& lc) noexcept
+{
+	if (&lc != this)
+	{
+		pool = std::move(lc.pool);
+		suffixIndex = std::move(lc.suffixIndex);
+		head = lc.head;
+		tail = lc.tail;
+		itemCount = lc.itemCount;
+		hashValue = lc.hashValue;
+		hashPower = lc.hashPower;
+		lc.head = nullptr;
+		lc.tail = nullptr;
+		lc.itemCount = 0;
+		lc.hashValue = 0;
+		lc.hashPower = 1;
+	}
+	return *this;
+}
+
+void LinkedChar::addItems(const char* source, int count)
+{
+	// Characters hash as 1..256 so leading zero bytes still count.
+	for (int i = 0; i < count; i++)
+		hashValue = hashAdd(hashMultiply(hashValue, HASH_BASE), static_cast<unsigned char>(source[i]) + 1u);
+	hashPower = hashMultiply(hashPower, (count == 1) ? HASH_BASE : hashBasePower(count));
+	addBlocks(source, count);
+}
+
+// Appends count characters, filling the last block before adding new ones.
+void LinkedChar::addBlocks(const char* source, int count)
+{
+	while (count > 0)
+	{
+		if (tail == nullptr || tail->isFull())
+		{
+			Node* newNode = pool.create();
+			if (tail == nullptr)
+				head = newNode;
+			else
+				tail->setNext(newNode);
+			tail = newNode;
+		}
+		int copied = tail->addItems(source, count);
+		if (suffixIndex)
+			suffixIndex->extend(source, copied);
+		source += copied;
+		count -= copied;
+		itemCount += copied;
+	}
+}
+
+void LinkedChar::display() 
+{
+	std::cout << "LinkedChar: '";
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+		std::cout.write(curr->getItems(), curr->getCount());
+	std::cout << "'";
+}
+
+void LinkedChar::add(const char item) 
+{
+	addItems(&item, 1);
+}
+
+int LinkedChar::length() const 
+{
+	return itemCount;
+}
+
+int LinkedChar::index(char ch) const
+{
+	int lcindex = 0;
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+	{
+		prefetchNext(curr);
+		const char* found = scanFirst(curr->getItems(), curr->getCount(), ch);
+		if (found != nullptr)
+			return lcindex + static_cast<int>(found - curr->getItems());
+		lcindex += curr->getCount();
+	}
+	return -1;
+}
+
+int LinkedChar::lastIndex(char ch) const
+{
+	// The chain only runs forward: remember the last block that held ch.
+	int result = -1;
+	int lcindex = 0;
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+	{
+		prefetchNext(curr);
+		const char* found = scanLast(curr->getItems(), curr->getCount(), ch);
+		if (found != nullptr)
+			result = lcindex + static_cast<int>(found - curr->getItems());
+		lcindex += curr->getCount();
+	}
+	return result;
+}
+
+int LinkedChar::count(char ch) const
+{
+	int total = 0;
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+	{
+		prefetchNext(curr);
+		total += scanCount(curr->getItems(), curr->getCount(), ch);
+	}
+	return total;
+}
+
+int LinkedChar::indexOfAny(const std::string& chars) const
+{
+	const CharSet set(chars.data(), static_cast<int>(chars.length()));
+	int lcindex = 0;
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+	{
+		prefetchNext(curr);
+		const char* found = scanFirstOf(curr->getItems(), curr->getCount(), set);
+		if (found != nullptr)
+			return lcindex + static_cast<int>(found - curr->getItems());
+		lcindex += curr->getCount();
+	}
+	return -1;
+}
+
+void LinkedChar::append(const LinkedChar & lc) 
+{
+	hashValue = hashAdd(hashMultiply(hashValue, lc.hashPower), lc.hashValue);
+	hashPower = hashMultiply(hashPower, lc.hashPower);
+	// Read lc's blocks before writing in case lc is this chain.
+	int remaining = lc.itemCount;
+	for (Node* curr = lc.head; remaining > 0; curr = curr->getNext())
+	{
+		int count = (curr->getCount() < remaining) ? curr->getCount() : remaining;
+		addBlocks(curr->getItems(), count);
+		remaining -= count;
+	}
+}
+
+void LinkedChar::append(LinkedChar && lc)
+{
+	if (&lc == this)
+	{
+		append(static_cast<const LinkedChar&>(lc));
+		return;
+	}
+	if (lc.head == nullptr)
+		return;
+	if (suffixIndex)
+		lc.forEachRun([this](const char* items, int count) { suffixIndex->extend(items, count); });
+	// lc's blocks move over with their pages; the old tail may stay
+	// partly filled, which every scan already allows for.
+	pool.adopt(lc.pool);
+	if (tail == nullptr)
+		head = lc.head;
+	else
+		tail->setNext(lc.head);
+	tail = lc.tail;
+	itemCount += lc.itemCount;
+	hashValue = hashAdd(hashMultiply(hashValue, lc.hashPower), lc.hashValue);
+	hashPower = hashMultiply(hashPower, lc.hashPower);
+	lc.head = nullptr;
+	lc.tail = nullptr;
+	lc.itemCount = 0;
+	lc.hashValue = 0;
+	lc.hashPower = 1;
+	// lc stays indexed, but of its now empty text.
+	if (lc.suffixIndex)
+		lc.suffixIndex.reset(new SuffixIndex());
+}
+
+std::uint64_t LinkedChar::hash() const
+{
+	return hashValue;
+}
+
+bool LinkedChar::operator==(const LinkedChar & lc) const
+{
+	if (itemCount != lc.itemCount || hashValue != lc.hashValue)
+		return false;
+	// Block boundaries can differ (splices leave partly filled blocks),
+	// so walk both chains by the shorter of the two remaining runs.
+	BlockCursor left = firstBlock();
+	BlockCursor right = lc.firstBlock();
+	int leftOffset = 0;
+	int rightOffset = 0;
+	while (!left.atEnd() && !right.atEnd())
+	{
+		const int leftRemaining = left.count() - leftOffset;
+		const int rightRemaining = right.count() - rightOffset;
+		const int span = (leftRemaining < rightRemaining) ? leftRemaining : rightRemaining;
+		if (std::memcmp(left.items() + leftOffset, right.items() + rightOffset, span) != 0)
+			return false;
+		leftOffset += span;
+		rightOffset += span;
+		if (leftOffset == left.count())
+		{
+			left.next();
+			leftOffset = 0;
+		}
+		if (rightOffset == right.count())
+		{
+			right.next();
+			rightOffset = 0;
+		}
+	}
+	return true;
+}
+
+bool LinkedChar::operator!=(const LinkedChar & lc) const
+{
+	return !(*this == lc);
+}
+
+std::string LinkedChar::toString() const
+{
+	std::string result;
+	result.reserve(itemCount);
+	for (Node* curr = head; curr != nullptr; curr = curr->getNext())
+		result.append(curr->getItems(), curr->getCount());
+	return result;
+}
+
+// Knuth-Morris-Pratt (see KmpMatcher.h), fed the chain block by block.
+int LinkedChar::search(const LinkedChar & lc, bool countAll) const
+{
+	const int m = lc.itemCount;
+	if (m == 0 || m > itemCount)
+		return countAll ? 0 : -1;
+	const KmpMatcher matcher(lc.toString());
+
+	int matched = 0;
+	int matches = 0;
+	int first = -1;
+	int position = 0;  // index of the first character of curr
+	for (Node* curr = head; curr != nullptr; position += curr->getCount(), curr = curr->getNext())
+	{
+		const bool more = matcher.step(curr->getItems(), curr->getCount(), matched, [&](int last)
+		{
+			matches++;
+			first = position + last - m + 1;
+			return countAll;
+		});
+		if (!more)
+			return first;
+	}
+	return countAll ? matches : -1;
+}
+
+int LinkedChar::find(const LinkedChar & lc) const
+{
+	if (suffixIndex)
+		return suffixIndex->firstIndex(lc);
+	return search(lc, false);
+}
+
+int LinkedChar::count(const LinkedChar & lc) const
+{
+	if (suffixIndex)
+		return suffixIndex->count(lc);
+	return search(lc, true);
+}
+
+void LinkedChar::buildIndex()
+{
+	suffixIndex.reset(new SuffixIndex(*this));
+}
+
+void LinkedChar::dropIndex()
+{
+	suffixIndex.reset();
+}
+
+bool LinkedChar::isIndexed() const
+{
+	return suffixIndex != nullptr;
+}
+
+bool LinkedChar::submatch(const LinkedChar & lc) const 
+{
+	return find(lc) >= 0;
+}
+
+LinkedChar::~LinkedChar() 
+{
+	// The blocks all live in pool's pages, which free in O(pages).
+	pool.release();
+	head = nullptr;
+	tail = nullptr;
+}
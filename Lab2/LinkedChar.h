@@ -0,0 +1,132 @@
+// Allen Lim
+
+/** LinkedChar: a character string stored as an unrolled linked list of
+ fixed-size character blocks.
+ @file LinkedChar.h */
+
+#ifndef LINKED_CHAR_
+#define LINKED_CHAR_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "Node.h"
+#include "NodePool.h"
+
+class SuffixIndex;
+
+class LinkedChar
+{
+private:
+	Node * head;
+	Node * tail;  // last block, so appends never walk the chain
+	int itemCount;
+	NodePool<Node> pool;  // owns every block of the chain
+	// Optional suffix automaton over the text; addBlocks extends it.
+	std::unique_ptr<SuffixIndex> suffixIndex;
+	// Polynomial hash of the text modulo 2^61 - 1 and HASH_BASE raised
+	// to the length, so appending a hashed chain costs O(1).
+	std::uint64_t hashValue;
+	std::uint64_t hashPower;
+
+	// Copies count characters into the chain without touching the hash.
+	void addBlocks(const char* source, int count);
+	// Hashes count characters, then copies them into the chain.
+	void addItems(const char* source, int count);
+	// KMP over the chain: the first match index, or with countAll the
+	// number of matches.
+	int search(const LinkedChar& lc, bool countAll) const;
+public:
+	LinkedChar();
+	// Both build the chain in one pass, filling whole blocks at a time.
+	LinkedChar(std::string_view s);
+	// Reads in until end of file.
+	explicit LinkedChar(std::istream& in);
+	// Copies build a fresh chain (and index, if lc has one); moves take
+	// over lc's blocks and index in O(1), leaving lc empty.
+	LinkedChar(const LinkedChar& lc);
+	LinkedChar(LinkedChar&& lc) noexcept;
+	LinkedChar& operator=(const LinkedChar& lc);
+	LinkedChar& operator=(LinkedChar&& lc) noexcept;
+	void display();
+	void add(const char item);
+	int length() const;
+	void append(const LinkedChar& lc);
+	// Splices lc's blocks onto the end in O(1), leaving lc empty.
+	void append(LinkedChar&& lc);
+	bool submatch(const LinkedChar& lc) const;
+	// Index of the first occurrence of lc in this LinkedChar, or -1.
+	// An empty lc is never found, as in submatch.
+	int find(const LinkedChar& lc) const;
+	// Number of (possibly overlapping) occurrences of lc.
+	int count(const LinkedChar& lc) const;
+
+	// Builds a suffix automaton over the text in O(n); afterwards find,
+	// submatch and count(lc) take O(lc.length()) whatever the length of
+	// this LinkedChar. add and append keep it up to date.
+	void buildIndex();
+	void dropIndex();
+	bool isIndexed() const;
+	// Character scans over whole blocks (see CharScan.h). index and
+	// lastIndex return -1 when ch does not occur; indexOfAny returns the
+	// first position holding any character of chars, or -1.
+	int index(char ch) const;
+	int lastIndex(char ch) const;
+	int count(char ch) const;
+	int indexOfAny(const std::string& chars) const;
+	std::string toString() const;
+
+	// A block of the chain and the index of its first character; lets a
+	// scanner start partway along the chain without walking it again.
+	class BlockCursor
+	{
+	private:
+		const Node* node;
+		int start;
+	public:
+		BlockCursor(const Node* anode, int astart) : node(anode), start(astart) {}
+		bool atEnd() const { return node == nullptr; }
+		const char* items() const { return node->getItems(); }
+		int count() const { return node->getCount(); }
+		int position() const { return start; }
+		void next() { start += node->getCount(); node = node->getNext(); }
+	};
+	BlockCursor firstBlock() const { return BlockCursor(head, 0); }
+
+	// Calls visit(items, count) with each block's contiguous run of
+	// characters, in order; lets scanners work on whole runs.
+	template<class Visitor>
+	void forEachRun(Visitor visit) const
+	{
+		for (const Node* curr = head; curr != nullptr; curr = curr->getNext())
+			visit(curr->getItems(), curr->getCount());
+	}
+
+	// Rolling hash of the contents: the same for equal strings however
+	// they were built, kept current by add and append.
+	std::uint64_t hash() const;
+	// Compares lengths and hashes before looking at any characters.
+	bool operator==(const LinkedChar& lc) const;
+	bool operator!=(const LinkedChar& lc) const;
+
+	~LinkedChar();
+};
+
+// Containers of chains must move them when they grow, not copy them.
+static_assert(std::is_nothrow_move_constructible<LinkedChar>::value, "LinkedChar moves must not throw");
+
+namespace std
+{
+template<>
+struct hash<LinkedChar>
+{
+	std::size_t operator()(const LinkedChar& lc) const { return static_cast<std::size_t>(lc.hash()); }
+};
+}
+
+#endif
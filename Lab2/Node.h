@@ -0,0 +1,45 @@
+// Allen Lim
+
+/** Block node for LinkedChar: an unrolled-list node holding up to
+ CAPACITY characters contiguously.
+ @file Node.h */
+
+#ifndef LAB2_NODE_
+#define LAB2_NODE_
+
+#include <cstring>
+
+class Node
+{
+public:
+	static const int CAPACITY = 64;
+private:
+	char items[CAPACITY];
+	int itemCount;
+	Node* next;
+public:
+	Node() : itemCount(0), next(nullptr) {}
+	Node(char aitem) : itemCount(1), next(nullptr) { items[0] = aitem; }
+
+	int getCount() const { return itemCount; }
+	bool isFull() const { return itemCount == CAPACITY; }
+	char getItem(int position) const { return items[position]; }
+	// The node's characters as one contiguous run of getCount() bytes.
+	const char* getItems() const { return items; }
+
+	// Precondition: !isFull().
+	void addItem(char aitem) { items[itemCount++] = aitem; }
+	// Copies as many of the count characters as fit; returns how many.
+	int addItems(const char* source, int count)
+	{
+		int copied = (count < CAPACITY - itemCount) ? count : CAPACITY - itemCount;
+		std::memcpy(items + itemCount, source, copied);
+		itemCount += copied;
+		return copied;
+	}
+
+	Node* getNext() const { return next; }
+	void setNext(Node* anode) { next = anode; }
+};
+
+#endif
@@ -0,0 +1,66 @@
+// Allen Lim
+
+/** @file ParallelSearch.cpp */
+
+#include "ParallelSearch.h"
+#include <atomic>
+#include "KmpMatcher.h"
+
+std::vector<int> parallelFindAll(const LinkedChar& text, const LinkedChar& pattern,
+                                 const ParallelSearchOptions& options)
+{
+	std::vector<int> hits;
+	const int m = pattern.length();
+	const int n = text.length();
+	if (m == 0 || m > n)
+		return hits;
+	const KmpMatcher matcher(pattern.toString());
+
+	// One pass down the chain records where each segment starts.
+	const int segmentSize = (options.segmentSize > 0) ? options.segmentSize : 1;
+	std::vector<LinkedChar::BlockCursor> starts;
+	for (LinkedChar::BlockCursor cursor = text.firstBlock(); !cursor.atEnd(); cursor.next())
+		if (starts.empty() || cursor.position() - starts.back().position() >= segmentSize)
+			starts.push_back(cursor);
+	const int segments = static_cast<int>(starts.size());
+
+	std::vector<std::vector<int>> segmentHits(segments);
+	std::atomic<bool> stop(false);
+	ThreadPool::of(options).parallelFor(0, segments, options.threadCount, [&](std::size_t segment)
+	{
+		const int s = static_cast<int>(segment);
+		// Matches starting in [begin, end) end before end + m - 1.
+		const int end = (s + 1 < segments) ? starts[s + 1].position() : n;
+		const int readEnd = (end + m - 1 < n) ? end + m - 1 : n;
+		int matched = 0;
+		for (LinkedChar::BlockCursor cursor = starts[s]; !cursor.atEnd() && cursor.position() < readEnd; cursor.next())
+		{
+			if (stop.load(std::memory_order_relaxed))
+				return;
+			const char* items = cursor.items();
+			const int count = (readEnd - cursor.position() < cursor.count()) ? readEnd - cursor.position() : cursor.count();
+			const bool more = matcher.step(items, count, matched, [&](int last)
+			{
+				segmentHits[s].push_back(cursor.position() + last - m + 1);
+				if (!options.stopAtFirstHit)
+					return true;
+				stop = true;
+				return false;
+			});
+			if (!more)
+				return;
+		}
+	});
+
+	// Segments are disjoint and in text order, so concatenating them
+	// keeps the hits sorted.
+	for (const std::vector<int>& found : segmentHits)
+		hits.insert(hits.end(), found.begin(), found.end());
+	return hits;
+}
+
+bool parallelSubmatch(const LinkedChar& text, const LinkedChar& pattern, ParallelSearchOptions options)
+{
+	options.stopAtFirstHit = true;
+	return !parallelFindAll(text, pattern, options).empty();
+}
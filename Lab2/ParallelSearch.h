@@ -0,0 +1,34 @@
+// Allen Lim
+
+/** Multi-threaded substring search over very large LinkedChar texts.
+ The text is cut into segments that workers on a thread pool take in
+ turn; each segment is searched with KMP, reading pattern length - 1
+ characters past its end so matches straddling a cut are found once.
+ @file ParallelSearch.h */
+
+#ifndef PARALLEL_SEARCH_
+#define PARALLEL_SEARCH_
+
+#include <vector>
+#include "LinkedChar.h"
+#include "ThreadPool.h"
+
+// ParallelOptions plus how the text is cut up and whether to stop early.
+struct ParallelSearchOptions : ParallelOptions
+{
+	// Characters per segment, rounded up to whole blocks.
+	int segmentSize = 1 << 22;
+	// Stop at the first match any worker finds, not necessarily the leftmost.
+	bool stopAtFirstHit = false;
+};
+
+// Index of every (possibly overlapping) occurrence of pattern in text, in
+// increasing order. An empty pattern never matches, as in find.
+std::vector<int> parallelFindAll(const LinkedChar& text, const LinkedChar& pattern,
+                                 const ParallelSearchOptions& options = ParallelSearchOptions());
+
+// text.submatch(pattern), returning as soon as any worker finds a match.
+bool parallelSubmatch(const LinkedChar& text, const LinkedChar& pattern,
+                      ParallelSearchOptions options = ParallelSearchOptions());
+
+#endif
@@ -0,0 +1,121 @@
+// Allen Lim
+
+/** @file PatternMatcher.cpp */
+
+#include "PatternMatcher.h"
+#include <queue>
+
+PatternMatcher::PatternMatcher() : compiled(false), classCount(1), states(1)
+{
+	for (int b = 0; b < 256; b++)
+		classOf[b] = 0;
+}
+
+int PatternMatcher::addPattern(const LinkedChar& pattern)
+{
+	patterns.push_back(pattern.toString());
+	compiled = false;
+	return static_cast<int>(patterns.size()) - 1;
+}
+
+int PatternMatcher::patternCount() const
+{
+	return static_cast<int>(patterns.size());
+}
+
+int PatternMatcher::stateCount() const
+{
+	return states;
+}
+
+void PatternMatcher::compile()
+{
+	// Alphabet compression: one class per distinct pattern byte.
+	for (int b = 0; b < 256; b++)
+		classOf[b] = 0;
+	classCount = 1;
+	for (const std::string& pattern : patterns)
+		for (unsigned char c : pattern)
+			if (classOf[c] == 0)
+				classOf[c] = static_cast<std::uint16_t>(classCount++);
+
+	// Trie of the patterns, one table row per state; -1 = no edge yet.
+	std::vector<std::int32_t> delta(classCount, -1);
+	std::vector<std::vector<std::int32_t>> ending(1);
+	states = 1;
+	for (int id = 0; id < static_cast<int>(patterns.size()); id++)
+	{
+		if (patterns[id].empty())
+			continue;
+		std::int32_t state = 0;
+		for (unsigned char c : patterns[id])
+		{
+			std::int32_t& edge = delta[state * classCount + classOf[c]];
+			if (edge < 0)
+			{
+				edge = states++;
+				delta.resize(static_cast<std::size_t>(states) * classCount, -1);
+				ending.emplace_back();
+			}
+			state = delta[state * classCount + classOf[c]];
+		}
+		ending[state].push_back(id);
+	}
+
+	// Breadth-first pass: set failure links and fill every missing edge
+	// with the failure state's edge, turning the trie into a DFA.
+	std::vector<std::int32_t> failure(states, 0);
+	firstReport.assign(states, -1);
+	nextReport.assign(states, -1);
+	std::queue<std::int32_t> pending;
+	for (int c = 0; c < classCount; c++)
+	{
+		if (delta[c] < 0)
+			delta[c] = 0;
+		else
+			pending.push(delta[c]);
+	}
+	while (!pending.empty())
+	{
+		std::int32_t s = pending.front();
+		pending.pop();
+		nextReport[s] = firstReport[failure[s]];
+		firstReport[s] = ending[s].empty() ? nextReport[s] : s;
+		for (int c = 0; c < classCount; c++)
+		{
+			std::int32_t& edge = delta[s * classCount + c];
+			std::int32_t fallback = delta[failure[s] * classCount + c];
+			if (edge < 0)
+				edge = fallback;
+			else
+			{
+				failure[edge] = fallback;
+				pending.push(edge);
+			}
+		}
+	}
+
+	endStart.assign(states + 1, 0);
+	endIds.clear();
+	for (int s = 0; s < states; s++)
+	{
+		endStart[s] = static_cast<std::int32_t>(endIds.size());
+		endIds.insert(endIds.end(), ending[s].begin(), ending[s].end());
+	}
+	endStart[states] = static_cast<std::int32_t>(endIds.size());
+
+	narrowTable.clear();
+	wideTable.clear();
+	if (states <= 0xFFFF)
+		narrowTable.assign(delta.begin(), delta.end());
+	else
+		wideTable.assign(delta.begin(), delta.end());
+	compiled = true;
+}
+
+std::vector<PatternMatch> PatternMatcher::findAll(const LinkedChar& text) const
+{
+	std::vector<PatternMatch> matches;
+	scan(text, [&matches](const PatternMatch& match) { matches.push_back(match); });
+	return matches;
+}
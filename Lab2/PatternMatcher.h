@@ -0,0 +1,109 @@
+// Allen Lim
+
+/** Aho-Corasick automaton: finds every occurrence of many LinkedChar
+ patterns in one pass over a LinkedChar text.
+ @file PatternMatcher.h */
+
+#ifndef PATTERN_MATCHER_
+#define PATTERN_MATCHER_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "LinkedChar.h"
+
+struct PatternMatch
+{
+	int pattern;  // id returned by addPattern
+	int index;    // index in the text of the match's first character
+};
+
+class PatternMatcher
+{
+private:
+	std::vector<std::string> patterns;
+	bool compiled;
+
+	// Bytes that occur in no pattern share class 0, so a row of the
+	// transition table has one column per distinct pattern byte plus one.
+	std::uint16_t classOf[256];
+	int classCount;
+	int states;
+	// Complete DFA, row-major by state: the next state for every
+	// (state, class), with failure links already folded in. Automata
+	// with fewer than 65536 states use the 16-bit table, halving its
+	// cache footprint; the other table is left empty.
+	std::vector<std::uint16_t> narrowTable;
+	std::vector<std::uint32_t> wideTable;
+	// firstReport[s]: s itself if some pattern ends at s, otherwise the
+	// nearest state on s's failure chain where one does, or -1.
+	// nextReport[s]: the same, starting from s's failure link.
+	std::vector<std::int32_t> firstReport;
+	std::vector<std::int32_t> nextReport;
+	// Ids of the patterns ending at state s: endIds[endStart[s]..endStart[s+1]).
+	std::vector<std::int32_t> endStart;
+	std::vector<std::int32_t> endIds;
+
+	template<class StateType, class Visitor>
+	void run(const std::vector<StateType>& table, const LinkedChar& text, Visitor visit) const;
+public:
+	PatternMatcher();
+
+	// Adds a pattern and returns its id (0, 1, 2, ...). Empty patterns
+	// never match. Adding after compile() requires compiling again.
+	int addPattern(const LinkedChar& pattern);
+	int patternCount() const;
+
+	// Builds the automaton from the patterns added so far.
+	void compile();
+	int stateCount() const;
+
+	// Calls visit(const PatternMatch&) for every occurrence of every
+	// pattern in text, ordered by where the match ends; matches ending
+	// at the same character come longest first. Throws std::logic_error
+	// if the automaton is not compiled.
+	template<class Visitor>
+	void scan(const LinkedChar& text, Visitor visit) const;
+
+	std::vector<PatternMatch> findAll(const LinkedChar& text) const;
+};
+
+template<class StateType, class Visitor>
+void PatternMatcher::run(const std::vector<StateType>& table, const LinkedChar& text, Visitor visit) const
+{
+	const StateType* delta = table.data();
+	const int stride = classCount;
+	std::size_t state = 0;
+	int position = 0;
+	text.forEachRun([&](const char* items, int count)
+	{
+		for (int i = 0; i < count; i++, position++)
+		{
+			state = delta[state * stride + classOf[static_cast<unsigned char>(items[i])]];
+			for (std::int32_t s = firstReport[state]; s >= 0; s = nextReport[s])
+			{
+				for (std::int32_t k = endStart[s]; k < endStart[s + 1]; k++)
+				{
+					PatternMatch match;
+					match.pattern = endIds[k];
+					match.index = position - static_cast<int>(patterns[endIds[k]].size()) + 1;
+					visit(match);
+				}
+			}
+		}
+	});
+}  // end run
+
+template<class Visitor>
+void PatternMatcher::scan(const LinkedChar& text, Visitor visit) const
+{
+	if (!compiled)
+		throw std::logic_error("PatternMatcher::scan: compile() has not been called");
+	if (!narrowTable.empty())
+		run(narrowTable, text, visit);
+	else
+		run(wideTable, text, visit);
+}  // end scan
+
+#endif
@@ -0,0 +1,195 @@
+// Allen Lim
+
+/** @file Similarity.cpp */
+
+#include "Similarity.h"
+#include "SuffixIndex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// How many text characters go by between early-exit checks; a check
+// costs about as much as one column.
+const int EXIT_CHECK_INTERVAL = 64;
+
+// One 64-row block of the DP column: vertical +1/-1 deltas and the DP
+// value in its bottom row.
+struct Block
+{
+	std::uint64_t pv;
+	std::uint64_t mv;
+	int score;
+};
+
+// Advances one block by one text character (Myers 1999, block form). eq
+// holds the rows whose pattern character equals the text character and
+// hin the horizontal delta entering the top of the block. Updates the
+// block and returns the horizontal delta leaving row bottomBit.
+inline int advanceBlock(Block& block, std::uint64_t eq, int hin, int bottomBit)
+{
+	const std::uint64_t pv = block.pv;
+	const std::uint64_t mv = block.mv;
+	const std::uint64_t xv = eq | mv;
+	eq |= static_cast<std::uint64_t>(hin < 0);
+	const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+	std::uint64_t ph = mv | ~(xh | pv);
+	std::uint64_t mh = pv & xh;
+	const int hout = static_cast<int>((ph >> bottomBit) & 1) - static_cast<int>((mh >> bottomBit) & 1);
+	ph = (ph << 1) | static_cast<std::uint64_t>(hin > 0);
+	mh = (mh << 1) | static_cast<std::uint64_t>(hin < 0);
+	block.pv = mh | ~(xv | ph);
+	block.mv = ph & xv;
+	block.score += hout;
+	return hout;
+}
+
+}  // end namespace
+
+int editDistance(const LinkedChar& a, const LinkedChar& b, int limit)
+{
+	// The shorter string runs down the bit columns, the longer across.
+	const bool aShorter = a.length() <= b.length();
+	const LinkedChar& pattern = aShorter ? a : b;
+	const LinkedChar& text = aShorter ? b : a;
+	const int m = pattern.length();
+	const int n = text.length();
+	const int cap = (limit >= 0 && limit < n) ? limit + 1 : n;
+	if (n - m >= cap)
+		return cap;
+
+	// peq[cls * words + w]: bit r set when pattern row 64w + r + 1 holds
+	// a character of class cls. Characters absent from the pattern share
+	// the all-zero class 0.
+	const int words = (m + 63) / 64;
+	const int lastBit = (m - 1) % 64;
+	int classOf[256] = { 0 };
+	int classCount = 1;
+	const std::string p = pattern.toString();
+	for (char ch : p)
+	{
+		int& cls = classOf[static_cast<unsigned char>(ch)];
+		if (cls == 0)
+			cls = classCount++;
+	}
+	std::vector<std::uint64_t> peq(static_cast<std::size_t>(classCount) * words, 0);
+	for (int i = 0; i < m; i++)
+		peq[classOf[static_cast<unsigned char>(p[i])] * words + i / 64] |= std::uint64_t(1) << (i % 64);
+	const std::string t = text.toString();
+
+	// Ukkonen's band: a cell (i, j) on an alignment costing at most
+	// band = cap - 1 has |i - j| <= band and |(m - i) - (n - j)| <= band,
+	// so column j only needs rows j - band .. j - (n - m) + band, i.e.
+	// blocks firstOf(j)..lastOf(j). Both only move down. Blocks that
+	// leave the top feed +1 into the next one; blocks joining at the
+	// bottom start as D[i] = D[i - 1] + 1. Either way the computed
+	// values can only be too large, and only where the true value is
+	// already above band, so results up to band stay exact.
+	const int band = cap - 1;
+	auto lastOf = [&](int column)
+	{
+		const int hi = column - (n - m) + band;
+		return (hi >= m) ? words - 1 : (hi - 1) / 64;
+	};
+	auto firstOf = [&](int column)
+	{
+		const int lo = column - band;
+		return (lo > 1) ? (lo - 1) / 64 : 0;
+	};
+	auto bottomBit = [&](int w) { return (w == words - 1) ? lastBit : 63; };
+	std::vector<Block> blocks(words);
+	auto startBlock = [&](int w)
+	{
+		blocks[w].pv = ~std::uint64_t(0);
+		blocks[w].mv = 0;
+		blocks[w].score = ((w > 0) ? blocks[w - 1].score : 0) + bottomBit(w) + 1;
+	};
+	startBlock(0);
+	int firstBlock = 0;
+	int lastBlock = 0;
+
+	// Block w of column j + 1 only waits for block w of column j and
+	// block w - 1 of column j + 1, so two columns advance together one
+	// block apart; their carry chains overlap instead of running back
+	// to back.
+	int nextCheck = EXIT_CHECK_INTERVAL;
+	for (int column = 0; column < n; )
+	{
+		const bool paired = column + 2 <= n;
+		const int first1 = (firstOf(column + 1) > firstBlock) ? firstOf(column + 1) : firstBlock;
+		const int last1 = lastOf(column + 1);
+		const int first2 = paired ? firstOf(column + 2) : words;
+		const int last2 = paired ? lastOf(column + 2) : -1;
+		for (; lastBlock < last1; lastBlock++)
+			startBlock(lastBlock + 1);
+
+		const std::uint64_t* eq1 = &peq[classOf[static_cast<unsigned char>(t[column])] * words];
+		const std::uint64_t* eq2 = paired ? &peq[classOf[static_cast<unsigned char>(t[column + 1])] * words] : eq1;
+		// Row 0 is D[0][j] = j, so +1 enters each column's top block.
+		int carry1 = 1;
+		int carry2 = 1;
+		const int end = (last2 + 1 > last1) ? last2 + 1 : last1;
+		for (int w = first1; w <= end; w++)
+		{
+			if (w <= last1)
+			{
+				carry1 = advanceBlock(blocks[w], eq1[w], carry1, bottomBit(w));
+				if (w == last1 && last2 > last1)
+					startBlock(last2);
+			}
+			const int v = w - 1;
+			if (v >= first2 && v <= last2)
+				carry2 = advanceBlock(blocks[v], eq2[v], carry2, bottomBit(v));
+		}
+		column += paired ? 2 : 1;
+		firstBlock = paired ? first2 : first1;
+		if (last2 > lastBlock)
+			lastBlock = last2;
+		if (limit < 0 || column < nextCheck)
+			continue;
+		nextCheck += EXIT_CHECK_INTERVAL;
+
+		// Every alignment crosses this column at some row r and then
+		// still needs |(m - r) - (n - column)| edits. Within block w
+		// (rows first..last) D[r] >= score - (last - r), which bounds
+		// the final distance from below.
+		const int shift = m - n + column;
+		int bound = column + ((shift > 0) ? shift : -shift);
+		for (int w = firstBlock; w <= lastBlock && bound > band; w++)
+		{
+			const int first = 64 * w + 1;
+			const int last = 64 * w + bottomBit(w) + 1;
+			const int reach = (shift >= first) ? shift : 2 * first - shift;
+			const int blockBound = blocks[w].score - last + reach;
+			if (blockBound < bound)
+				bound = blockBound;
+		}
+		if (bound > band)
+			return cap;
+	}
+	return (blocks[words - 1].score > cap) ? cap : blocks[words - 1].score;
+}
+
+bool withinEditDistance(const LinkedChar& a, const LinkedChar& b, int k)
+{
+	return k >= 0 && editDistance(a, b, k) <= k;
+}
+
+CommonSubstring longestCommonSubstring(const LinkedChar& a, const LinkedChar& b)
+{
+	// Index the shorter string; the automaton is the larger structure.
+	CommonSubstring result;
+	if (a.length() <= b.length())
+	{
+		SuffixIndex index(a);
+		result.length = index.longestCommonSubstring(b, result.firstIndex, result.secondIndex);
+	}
+	else
+	{
+		SuffixIndex index(b);
+		result.length = index.longestCommonSubstring(a, result.secondIndex, result.firstIndex);
+	}
+	return result;
+}
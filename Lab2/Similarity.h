@@ -0,0 +1,35 @@
+// Allen Lim
+
+/** Similarity measures between LinkedChars: Levenshtein edit distance by
+ Myers' bit-parallel algorithm, with Hyyro's multi-word blocks, and the
+ longest common substring by a suffix automaton.
+ @file Similarity.h */
+
+#ifndef SIMILARITY_
+#define SIMILARITY_
+
+#include "LinkedChar.h"
+
+// Minimum number of single-character insertions, deletions and
+// substitutions turning a into b. Takes O(n * ceil(m / 64)) word
+// operations, where m <= n are the two lengths.
+//
+// With limit >= 0 the result is exact up to limit and limit + 1 for
+// anything larger; the computation stops as soon as the distance is
+// known to exceed limit.
+int editDistance(const LinkedChar& a, const LinkedChar& b, int limit = -1);
+
+// True when editDistance(a, b) <= k.
+bool withinEditDistance(const LinkedChar& a, const LinkedChar& b, int k);
+
+struct CommonSubstring
+{
+	int length;
+	int firstIndex;   // where it first occurs in the first argument, or -1
+	int secondIndex;  // where it first occurs in the second argument, or -1
+};
+
+// Longest string occurring in both a and b, in O(|a| + |b|).
+CommonSubstring longestCommonSubstring(const LinkedChar& a, const LinkedChar& b);
+
+#endif
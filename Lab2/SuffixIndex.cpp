@@ -0,0 +1,268 @@
+// Allen Lim
+
+/** @file SuffixIndex.cpp */
+
+#include "SuffixIndex.h"
+#include "LinkedChar.h"
+
+SuffixIndex::SuffixIndex() : last(0), textLength(0), countsStale(true)
+{
+	addState(0, -1, false);
+}
+
+SuffixIndex::SuffixIndex(const LinkedChar& text) : SuffixIndex()
+{
+	// At most 2n states.
+	states.reserve(2 * static_cast<std::size_t>(text.length()) + 1);
+	text.forEachRun([this](const char* items, int count) { extend(items, count); });
+}
+
+int SuffixIndex::addState(int length, int end, bool isClone)
+{
+	State state;
+	state.len = length;
+	state.link = -1;
+	state.firstEnd = end;
+	state.overflow = -1;
+	state.denseRow = -1;
+	state.degree = 0;
+	state.cloned = isClone;
+	states.push_back(state);
+	return static_cast<int>(states.size()) - 1;
+}
+
+int SuffixIndex::target(int state, unsigned char label) const
+{
+	const State& s = states[state];
+	if (s.denseRow >= 0)
+		return denseRows[s.denseRow + label];
+	const int inlined = (s.degree < INLINE_EDGES) ? s.degree : INLINE_EDGES;
+	for (int k = 0; k < inlined; k++)
+		if (s.labels[k] == label)
+			return s.targets[k];
+	for (int e = s.overflow; e >= 0; e = edges[e].next)
+		if (edges[e].label == label)
+			return edges[e].to;
+	return -1;
+}
+
+void SuffixIndex::setTarget(int state, unsigned char label, int to)
+{
+	State& s = states[state];
+	if (s.denseRow >= 0)
+		denseRows[s.denseRow + label] = to;
+	const int inlined = (s.degree < INLINE_EDGES) ? s.degree : INLINE_EDGES;
+	for (int k = 0; k < inlined; k++)
+	{
+		if (s.labels[k] == label)
+		{
+			s.targets[k] = to;
+			return;
+		}
+	}
+	for (int e = s.overflow; e >= 0; e = edges[e].next)
+	{
+		if (edges[e].label == label)
+		{
+			edges[e].to = to;
+			return;
+		}
+	}
+}
+
+void SuffixIndex::addEdge(int state, unsigned char label, int to)
+{
+	State& s = states[state];
+	if (s.degree < INLINE_EDGES)
+	{
+		s.labels[s.degree] = label;
+		s.targets[s.degree] = to;
+	}
+	else
+	{
+		Edge edge;
+		edge.to = to;
+		edge.next = s.overflow;
+		edge.label = label;
+		s.overflow = static_cast<int>(edges.size());
+		edges.push_back(edge);
+	}
+	s.degree++;
+	if (s.denseRow >= 0)
+		denseRows[s.denseRow + label] = to;
+	else if (s.degree > DENSE_AFTER)
+		makeDense(state);
+}
+
+void SuffixIndex::makeDense(int state)
+{
+	State& s = states[state];
+	s.denseRow = static_cast<int>(denseRows.size());
+	denseRows.resize(denseRows.size() + 256, -1);
+	for (int k = 0; k < INLINE_EDGES; k++)
+		denseRows[s.denseRow + s.labels[k]] = s.targets[k];
+	for (int e = s.overflow; e >= 0; e = edges[e].next)
+		denseRows[s.denseRow + edges[e].label] = edges[e].to;
+}
+
+// Copies q's transitions to the fresh state clone.
+void SuffixIndex::copyEdges(int clone, int q)
+{
+	const int inlined = (states[q].degree < INLINE_EDGES) ? states[q].degree : INLINE_EDGES;
+	for (int k = 0; k < inlined; k++)
+		addEdge(clone, states[q].labels[k], states[q].targets[k]);
+	for (int e = states[q].overflow; e >= 0; e = edges[e].next)
+		addEdge(clone, edges[e].label, edges[e].to);
+}
+
+// Standard online construction (Blumer et al.): each character adds one
+// state for the new text and at most one clone.
+void SuffixIndex::extend(const char* items, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		const unsigned char c = static_cast<unsigned char>(items[i]);
+		const int current = addState(states[last].len + 1, textLength, false);
+		int p = last;
+		while (p >= 0 && target(p, c) < 0)
+		{
+			addEdge(p, c, current);
+			p = states[p].link;
+		}
+		if (p < 0)
+			states[current].link = 0;
+		else
+		{
+			const int q = target(p, c);
+			if (states[p].len + 1 == states[q].len)
+				states[current].link = q;
+			else
+			{
+				const int clone = addState(states[p].len + 1, states[q].firstEnd, true);
+				copyEdges(clone, q);
+				states[clone].link = states[q].link;
+				while (p >= 0 && target(p, c) == q)
+				{
+					setTarget(p, c, clone);
+					p = states[p].link;
+				}
+				states[q].link = clone;
+				states[current].link = clone;
+			}
+		}
+		last = current;
+		textLength++;
+	}
+	if (count > 0)
+		invalidate();
+}
+
+void SuffixIndex::invalidate()
+{
+	countsStale = true;
+}
+
+void SuffixIndex::countOccurrences() const
+{
+	// Every non-clone state is one end position; pass counts up the
+	// suffix links from the longest states down (counting sort by len).
+	const int n = stateCount();
+	std::vector<int> bucket(textLength + 2, 0);
+	for (int s = 0; s < n; s++)
+		bucket[states[s].len + 1]++;
+	for (int l = 1; l <= textLength + 1; l++)
+		bucket[l] += bucket[l - 1];
+	std::vector<int> order(n);
+	for (int s = 0; s < n; s++)
+		order[bucket[states[s].len]++] = s;
+
+	occurrences.assign(n, 0);
+	for (int s = 1; s < n; s++)
+		occurrences[s] = states[s].cloned ? 0 : 1;
+	for (int k = n - 1; k > 0; k--)
+		occurrences[states[order[k]].link] += occurrences[order[k]];
+	countsStale = false;
+}
+
+int SuffixIndex::walk(const LinkedChar& pattern) const
+{
+	if (pattern.length() == 0)
+		return -1;
+	int state = 0;
+	pattern.forEachRun([&](const char* items, int count)
+	{
+		for (int i = 0; i < count && state >= 0; i++)
+			state = target(state, static_cast<unsigned char>(items[i]));
+	});
+	return state;
+}
+
+int SuffixIndex::length() const
+{
+	return textLength;
+}
+
+int SuffixIndex::stateCount() const
+{
+	return static_cast<int>(states.size());
+}
+
+bool SuffixIndex::contains(const LinkedChar& pattern) const
+{
+	return walk(pattern) >= 0;
+}
+
+int SuffixIndex::firstIndex(const LinkedChar& pattern) const
+{
+	int state = walk(pattern);
+	return (state < 0) ? -1 : states[state].firstEnd - pattern.length() + 1;
+}
+
+int SuffixIndex::count(const LinkedChar& pattern) const
+{
+	int state = walk(pattern);
+	if (state < 0)
+		return 0;
+	if (countsStale)
+		countOccurrences();
+	return occurrences[state];
+}
+
+int SuffixIndex::longestCommonSubstring(const LinkedChar& other, int& textIndex, int& otherIndex) const
+{
+	// Walk other through the automaton, keeping the longest suffix of
+	// other[0..i] that occurs in the text: on a miss, fall back along
+	// suffix links until the character can be read.
+	int state = 0;
+	int matched = 0;
+	int best = 0;
+	int bestState = 0;
+	int bestEnd = -1;
+	int position = 0;
+	other.forEachRun([&](const char* items, int count)
+	{
+		for (int i = 0; i < count; i++, position++)
+		{
+			const unsigned char c = static_cast<unsigned char>(items[i]);
+			while (state > 0 && target(state, c) < 0)
+			{
+				state = states[state].link;
+				matched = states[state].len;
+			}
+			const int next = target(state, c);
+			if (next < 0)
+				continue;
+			state = next;
+			matched++;
+			if (matched > best)
+			{
+				best = matched;
+				bestState = state;
+				bestEnd = position;
+			}
+		}
+	});
+	textIndex = (best == 0) ? -1 : states[bestState].firstEnd - best + 1;
+	otherIndex = (best == 0) ? -1 : bestEnd - best + 1;
+	return best;
+}
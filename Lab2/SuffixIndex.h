@@ -0,0 +1,102 @@
+// Allen Lim
+
+/** SuffixIndex: suffix automaton over a LinkedChar's text. Once built it
+ answers whether a pattern occurs, where it first occurs and how many
+ times it occurs in O(m) for a pattern of length m, whatever the text
+ length. It extends online as characters are appended.
+ @file SuffixIndex.h */
+
+#ifndef SUFFIX_INDEX_
+#define SUFFIX_INDEX_
+
+#include <vector>
+
+class LinkedChar;
+
+class SuffixIndex
+{
+private:
+	struct Edge
+	{
+		int to;
+		int next;  // next overflow edge of the same state, or -1
+		unsigned char label;
+	};
+
+	static const int INLINE_EDGES = 4;
+	static const int DENSE_AFTER = 8;
+
+	// A state recognizes the substrings whose sets of end positions are
+	// the same: len is the longest of them, link the state of its longest
+	// suffix in another class, and firstEnd the smallest end position
+	// (index of the last character). Clones are split off existing states
+	// and own no end position of their own.
+	//
+	// The first INLINE_EDGES transitions live in the state itself, so on
+	// small alphabets a step costs one memory access; the rest go on a
+	// linked overflow list in edges. States with more than DENSE_AFTER
+	// transitions (in practice the few near the start state, which
+	// suffix-link walks visit constantly) also get a 256-entry row in
+	// denseRows for one-step lookups.
+	struct State
+	{
+		int len;
+		int link;
+		int firstEnd;
+		int overflow;  // head of the overflow edge list, or -1
+		int denseRow;  // offset of the state's row in denseRows, or -1
+		short degree;
+		bool cloned;
+		unsigned char labels[INLINE_EDGES];
+		int targets[INLINE_EDGES];
+	};
+
+	std::vector<State> states;
+	std::vector<Edge> edges;
+	std::vector<int> denseRows;
+	int last;        // state of the whole text
+	int textLength;
+
+	// occurrences[s]: number of end positions of s, i.e. how many times
+	// each substring in s occurs. Rebuilt on demand after invalidate().
+	mutable std::vector<int> occurrences;
+	mutable bool countsStale;
+
+	int addState(int length, int end, bool isClone);
+	int target(int state, unsigned char label) const;
+	void setTarget(int state, unsigned char label, int to);
+	void addEdge(int state, unsigned char label, int to);
+	void makeDense(int state);
+	void copyEdges(int clone, int q);
+	// State reached by reading pattern from the start state, or -1 if
+	// pattern does not occur; empty patterns give -1.
+	int walk(const LinkedChar& pattern) const;
+	void countOccurrences() const;
+public:
+	// An index of the empty text.
+	SuffixIndex();
+	explicit SuffixIndex(const LinkedChar& text);
+
+	// Appends characters to the indexed text in amortized O(1) each.
+	// LinkedChar calls this from add and append to keep its index current.
+	void extend(const char* items, int count);
+	// Marks the occurrence counts stale; the next count() rebuilds them
+	// in O(n). extend() calls it.
+	void invalidate();
+
+	int length() const;
+	int stateCount() const;
+
+	// Empty patterns never occur, as in LinkedChar::submatch.
+	bool contains(const LinkedChar& pattern) const;
+	// Index of the first character of pattern's first occurrence, or -1.
+	int firstIndex(const LinkedChar& pattern) const;
+	// Number of (possibly overlapping) occurrences of pattern.
+	int count(const LinkedChar& pattern) const;
+	// Length of the longest substring of other that occurs in the indexed
+	// text, found in one O(|other|) pass. textIndex and otherIndex get the
+	// indices of its first occurrences in each, or -1 if the length is 0.
+	int longestCommonSubstring(const LinkedChar& other, int& textIndex, int& otherIndex) const;
+};
+
+#endif
@@ -1,163 +1,81 @@
 // Allen Lim
 
-#include <iostream>
-#include <string>
-
-class Node {
-private:
-	char item;
-	Node * next;
-public:
-	Node(char aitem) :item(aitem), next(nullptr) {}
-	char getItem();
-	void setItem(char aitem);
-	Node* getNext();
-	void setNext(Node* anode);
-};
-
-char Node::getItem()
-{
-	return item;
-}
+/** usage: charchain_exe [--check]
 
-void Node::setItem(char aitem)
-{
-	item = aitem;
-}
-
-Node * Node::getNext()
-{
-	return next;
-}
+ With no argument, reads a string and runs the interactive menu. With
+ --check, runs the self-checks below, prints one line per check and exits
+ non-zero if any fails.
+ @file charchain.cpp */
 
-void Node::setNext(Node* anode)
-{
-	next = anode;
-}
-
-class LinkedChar
-{
-private:
-	Node * head;
-	int itemCount;
-public:
-	LinkedChar();
-	LinkedChar(std::string s);
-	void display();
-	void add(const char item);
-	int length() const;
-	void append(const LinkedChar& lc);
-	bool submatch(const LinkedChar& lc) const;
-	int index(char ch) const;
-	~LinkedChar();
-};
-
-LinkedChar::LinkedChar()
-{
-	head = nullptr;
-	itemCount = 0;
-}
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "LinkedChar.h"
+#include "PatternMatcher.h"
 
-LinkedChar::LinkedChar(std::string s)
+// Prints what with its outcome and returns passed.
+bool check(bool passed, const char* what)
 {
-	head = nullptr;
-	itemCount = 0;
-	for (int i = 0; i < s.length(); i++) 
-		add(s[i]);
+	std::cout << (passed ? "ok      " : "FAILED  ") << what << "\n";
+	return passed;
 }
 
-void LinkedChar::display() 
+int selfCheck()
 {
-	Node * curr = head;
-	std::cout << "LinkedChar: '";
-	while (curr != nullptr) {
-		std::cout << curr->getItem();
-		curr = curr->getNext();
-	}
-	std::cout << "'";
-}
+	bool passed = true;
 
-void LinkedChar::add(const char item) 
-{
-	Node * newNode = new Node(item);
-	if (head == nullptr)
-		head = newNode;
-	else 
+	// A spliced-away chain must not answer from its old index.
 	{
-		Node* curr = head;
-		while (curr->getNext() != nullptr)
-			curr = curr->getNext();
-		curr->setNext(newNode);
+		LinkedChar target("h"), source("ello");
+		source.buildIndex();
+		target.append(std::move(source));
+		source.add('z');
+		passed &= check(source.find(LinkedChar("ell")) < 0 && source.count(LinkedChar("ell")) == 0
+		                && source.find(LinkedChar("z")) == 0 && target.find(LinkedChar("ell")) == 1,
+		                "splice resets the moved-from chain's index");
 	}
-	itemCount++;
-}
-
-int LinkedChar::length() const 
-{
-	return itemCount;
-}
 
-int LinkedChar::index(char ch) const
-{
-	int lcindex = 0;
-	Node * curr = head;
-	while (curr != nullptr  && curr->getItem() != ch)
+	// Overlapping patterns, including two ending at the same character.
 	{
-		++lcindex;
-		curr = curr->getNext();
+		PatternMatcher matcher;
+		for (const char* pattern : { "he", "she", "his", "hers" })
+			matcher.addPattern(LinkedChar(pattern));
+		matcher.compile();
+		const std::vector<PatternMatch> found = matcher.findAll(LinkedChar("ushers"));
+		const std::vector<std::pair<int, int>> expected = { { 1, 1 }, { 0, 2 }, { 3, 2 } };
+		std::vector<std::pair<int, int>> actual;
+		for (const PatternMatch& match : found)
+			actual.emplace_back(match.pattern, match.index);
+		passed &= check(actual == expected, "PatternMatcher reports she, he, hers in \"ushers\"");
 	}
-	if (curr == nullptr)
-		return -1;
-	else
-		return lcindex;
-}
 
-
-void LinkedChar::append(const LinkedChar & lc) 
-{
-	Node* curr = lc.head;
-	while (curr != nullptr) 
+	// Equal text built two ways must compare and hash equal; a one-character
+	// difference or a longer chain must not compare equal.
 	{
-		add(curr->getItem());
-		curr = curr->getNext();
+		LinkedChar whole("the quick brown fox"), pieces("the quick");
+		pieces.append(LinkedChar(" brown fox"));
+		std::hash<LinkedChar> hasher;
+		passed &= check(whole == pieces && hasher(whole) == hasher(pieces), "equal chains compare and hash equal");
+		passed &= check(whole != LinkedChar("the quick brown fix") && whole != LinkedChar("the quick brown foxes"),
+		                "unequal chains compare unequal");
 	}
-}
 
-bool LinkedChar::submatch(const LinkedChar & lc) const 
-{
-	Node* lcPtr = head;
-	Node* subPtr = lc.head;
-	if (subPtr == nullptr)
-		return false;
-	while (lcPtr != nullptr)
+	// The stream constructor reads 64 KiB at a time: cross that boundary.
 	{
-		if (lcPtr->getItem() == subPtr->getItem() && subPtr->getNext() == nullptr) // match and end of sub (submatch is true)
-			return true;
-		else if (lcPtr->getItem() == subPtr->getItem()) // match but not end of sub (move both pointers)
-		{
-			lcPtr = lcPtr->getNext();
-			subPtr = subPtr->getNext();
-		}
-		else if (lc.head->getItem() == lcPtr->getItem()) // no match but sub.head matches lcPtr->getItem (reset subPtr and don't move lcPtr)
-			subPtr = lc.head;
-		else // no match and sub.head doesn't match lcPtr->getItem (reset subPtr and move lcPtr)
-		{
-			subPtr = lc.head;
-			lcPtr = lcPtr->getNext();
-		}
+		std::string text;
+		for (int i = 0; i < (1 << 16) + 100; i++)
+			text += static_cast<char>('a' + i % 23);
+		std::istringstream in(text);
+		const LinkedChar read(in);
+		passed &= check(read.length() == static_cast<int>(text.size()) && read == LinkedChar(text) && read.toString() == text,
+		                "stream read spanning a 64 KiB boundary");
 	}
-	return false;
-}
 
-LinkedChar::~LinkedChar() 
-{
-	while (head != nullptr) 
-	{
-		Node *oldPtr = head;
-		head = head->getNext();
-		delete oldPtr;
-	}
-}
+	return passed ? 0 : 1;
+}  // end selfCheck
 
 void menuDisplay()
 {
@@ -169,8 +87,16 @@ void menuDisplay()
 	std::cout << "[5] Exit\n\n";
 }
 
-int main() 
+int main(int argc, char* argv[])
 {
+	if (argc > 2 || (argc == 2 && std::string(argv[1]) != "--check"))
+	{
+		std::cerr << "usage: " << argv[0] << " [--check]\n";
+		return 1;
+	}
+	if (argc == 2)
+		return selfCheck();
+
 	std::string newstring;
 	std::cout << "Enter a string and convert to LinkedChar: ";
 	std::getline(std::cin, newstring);
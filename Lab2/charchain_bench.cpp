@@ -0,0 +1,214 @@
+// Allen Lim
+
+/** Benchmarks LinkedChar::find on adversarial inputs to show the search
+ stays linear in text plus pattern length, the block character
+ scans (index, lastIndex, count, indexOfAny) against a byte-at-a-time loop,
+ repeated queries against a text with and without its suffix index, the
+ similarity measures on pairs of chains, and the parallel search at a
+ few thread counts.
+
+ usage: charchain_bench [--max-size N]
+
+ Each family is run at growing text sizes; ns/char should stay flat as
+ the text grows and as the pattern grows. A naive backtracking search
+ over the same text is timed alongside (on the smaller sizes only) to
+ show the quadratic behavior the families provoke. The scans are run
+ over text that never holds the target, so every byte is read.
+ @file charchain_bench.cpp */
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include "Bench.h"
+#include "LinkedChar.h"
+#include "ParallelSearch.h"
+#include "Similarity.h"
+
+struct Family
+{
+	const char* name;
+	std::function<std::string(std::size_t)> text;
+	std::function<std::string(std::size_t)> pattern;
+};
+
+// Restarts one past each failed alignment: O(n * m) on these families.
+int naiveFind(const std::string& text, const std::string& pattern)
+{
+	for (std::size_t start = 0; start + pattern.size() <= text.size(); start++)
+	{
+		std::size_t k = 0;
+		while (k < pattern.size() && text[start + k] == pattern[k])
+			k++;
+		if (k == pattern.size())
+			return static_cast<int>(start);
+	}
+	return -1;
+}  // end naiveFind
+
+// Baseline for the block kernels: walks the same blocks but compares one
+// character at a time, so the gap to index() is the kernels alone.
+int byteLoopIndex(const LinkedChar& chain, char ch)
+{
+	int position = 0;
+	int result = -1;
+	chain.forEachRun([&](const char* items, int count)
+	{
+		for (int i = 0; i < count && result < 0; i++)
+			if (items[i] == ch)
+				result = position + i;
+		position += count;
+	});
+	return result;
+}  // end byteLoopIndex
+
+int main(int argc, char* argv[])
+{
+	std::size_t maxSize = 10000000;
+	if (!BenchArgs().option("--max-size", "N", maxSize).parse(argc, argv))
+		return 1;
+
+	Family families[] = {
+		// a^n against a^(m-1)b: every alignment matches m-1 characters.
+		{ "a^n / a^(m-1)b",
+		  [](std::size_t n) { return std::string(n, 'a'); },
+		  [](std::size_t m) { return std::string(m - 1, 'a') + 'b'; } },
+		// (ab)^n against (ab)^k b, k = (m - 1) / 2: long periodic partial matches.
+		{ "(ab)^n / (ab)^kb",
+		  [](std::size_t n) { std::string s; for (std::size_t i = 0; i < n; i++) s += "ab"[i % 2]; return s; },
+		  [](std::size_t m) { std::string s; for (std::size_t i = 0; i < (m - 1) / 2; i++) s += "ab"; return s + 'b'; } },
+		// Random text over {a, b}, absent random pattern: the typical case.
+		{ "random {a,b}",
+		  [](std::size_t n) { std::mt19937 g(1); std::string s; for (std::size_t i = 0; i < n; i++) s += "ab"[g() % 2]; return s; },
+		  [](std::size_t m) { return std::string(m - 1, 'a') + 'c'; } },
+	};
+
+	const std::size_t naiveLimit = 100000;
+	std::printf("%-18s %10s %6s %12s %12s\n", "family", "n", "m", "find ns/ch", "naive ns/ch");
+	for (const Family& family : families)
+	{
+		for (std::size_t m : { std::size_t(10), std::size_t(1000) })
+		{
+			for (std::size_t n = 10000; n <= maxSize; n *= 10)
+			{
+				std::string text = family.text(n);
+				std::string pattern = family.pattern(m);
+				LinkedChar textChain(text);
+				LinkedChar patternChain(pattern);
+				volatile int sink = 0;
+				double findSeconds = bestTime([&] { sink = sink + textChain.find(patternChain); });
+				std::printf("%-18s %10zu %6zu %12.3f", family.name, n, m, findSeconds * 1e9 / n);
+				if (n <= naiveLimit)
+				{
+					double naiveSeconds = bestTime([&] { sink = sink + naiveFind(text, pattern); });
+					std::printf(" %12.3f\n", naiveSeconds * 1e9 / n);
+				}
+				else
+					std::printf(" %12s\n", "-");
+			}
+		}
+	}
+
+	std::printf("\n%-12s %10s %12s %8s\n", "scan", "n", "ns/ch", "GB/s");
+	for (std::size_t n = 10000; n <= maxSize; n *= 10)
+	{
+		LinkedChar textChain(std::string(n, 'a'));
+		volatile int sink = 0;
+		std::pair<const char*, std::function<void()>> scans[] = {
+			{ "byte loop", [&] { sink = sink + byteLoopIndex(textChain, 'z'); } },
+			{ "index", [&] { sink = sink + textChain.index('z'); } },
+			{ "lastIndex", [&] { sink = sink + textChain.lastIndex('z'); } },
+			{ "count", [&] { sink = sink + textChain.count('z'); } },
+			{ "indexOfAny", [&] { sink = sink + textChain.indexOfAny("xyz"); } },
+		};
+		for (const auto& scan : scans)
+		{
+			double seconds = bestTime(scan.second);
+			std::printf("%-12s %10zu %12.3f %8.2f\n", scan.first, n, seconds * 1e9 / n, n / seconds / 1e9);
+		}
+	}
+
+	// 1000 patterns of length 12, half taken from the text, half random.
+	std::printf("\n%-12s %10s %10s %14s %14s\n", "queries", "n", "build ms", "find us/query", "count us/query");
+	for (std::size_t n = 10000; n <= maxSize; n *= 10)
+	{
+		std::mt19937 generator(7);
+		std::string text;
+		for (std::size_t i = 0; i < n; i++)
+			text += "acgt"[generator() % 4];
+		std::vector<LinkedChar> patterns;
+		for (int q = 0; q < 1000; q++)
+		{
+			std::string pattern = text.substr(generator() % (n - 12), 12);
+			if (q % 2 == 1)
+				pattern[generator() % 12] = "acgt"[generator() % 4];
+			patterns.emplace_back(pattern);
+		}
+		LinkedChar textChain(text);
+		for (bool indexed : { false, true })
+		{
+			double buildSeconds = 0;
+			if (indexed)
+				buildSeconds = bestTime([&] { textChain.buildIndex(); });
+			volatile int sink = 0;
+			double findSeconds = bestTime([&] { for (const LinkedChar& p : patterns) sink = sink + textChain.find(p); });
+			double countSeconds = bestTime([&] { for (const LinkedChar& p : patterns) sink = sink + textChain.count(p); });
+			std::printf("%-12s %10zu %10.1f %14.3f %14.3f\n", indexed ? "indexed" : "kmp", n,
+			            buildSeconds * 1e3, findSeconds * 1e6 / patterns.size(), countSeconds * 1e6 / patterns.size());
+		}
+	}
+
+	// Pairs of equal length: a near-duplicate with 1% of its characters
+	// replaced, and an unrelated string.
+	std::printf("\n%-22s %8s %12s %8s\n", "similarity", "n", "us/pair", "result");
+	for (std::size_t n = 1000; n <= std::min<std::size_t>(maxSize, 100000); n *= 10)
+	{
+		std::mt19937 generator(11);
+		std::string first, unrelated;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			first += static_cast<char>('a' + generator() % 26);
+			unrelated += static_cast<char>('a' + generator() % 26);
+		}
+		std::string nearCopy = first;
+		for (std::size_t e = 0; e < n / 100; e++)
+			nearCopy[generator() % n] = '#';
+		LinkedChar a(first), b(nearCopy), c(unrelated);
+		const int limit = static_cast<int>(n / 50);
+		std::pair<const char*, std::function<int()>> measures[] = {
+			{ "distance near-dup", [&] { return editDistance(a, b); } },
+			{ "distance unrelated", [&] { return editDistance(a, c); } },
+			{ "within n/50 near-dup", [&] { return editDistance(a, b, limit); } },
+			{ "within n/50 unrelated", [&] { return editDistance(a, c, limit); } },
+			{ "common substring", [&] { return longestCommonSubstring(a, b).length; } },
+		};
+		for (const auto& measure : measures)
+		{
+			int result = 0;
+			double seconds = bestTime([&] { result = measure.second(); });
+			std::printf("%-22s %8zu %12.2f %8d\n", measure.first, n, seconds * 1e6, result);
+		}
+	}
+
+	// The longest a^n text against an absent pattern: every worker scans
+	// its whole share.
+	{
+		const std::size_t n = maxSize;
+		LinkedChar textChain(std::string(n, 'a'));
+		LinkedChar patternChain(std::string(31, 'a') + 'b');
+		std::printf("\n%-12s %10s %8s %12s\n", "parallel", "n", "threads", "ns/ch");
+		volatile int sink = 0;
+		double seconds = bestTime([&] { sink = sink + textChain.find(patternChain); });
+		std::printf("%-12s %10zu %8s %12.3f\n", "find", n, "-", seconds * 1e9 / n);
+		for (unsigned threads : { 1u, 2u, 4u, ThreadPool::shared().size() })
+		{
+			ParallelSearchOptions options;
+			options.threadCount = threads;
+			seconds = bestTime([&] { sink = sink + static_cast<int>(parallelFindAll(textChain, patternChain, options).size()); });
+			std::printf("%-12s %10zu %8u %12.3f\n", "findAll", n, threads, seconds * 1e9 / n);
+		}
+	}
+	return 0;
+}
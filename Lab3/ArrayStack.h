@@ -0,0 +1,178 @@
+// Allen Lim
+
+/** Stack of ints in one contiguous array. The first INLINE_CAPACITY
+ items live inside the stack object itself, so shallow stacks never
+ touch the heap; deeper stacks spill to a heap buffer that doubles as
+ needed. Same interface as LinkedStack.
+ @file ArrayStack.h */
+
+#ifndef ARRAY_STACK_
+#define ARRAY_STACK_
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template<int INLINE_CAPACITY = 32>
+class ArrayStack
+{
+	static_assert(INLINE_CAPACITY > 0, "ArrayStack needs room for at least one inline item");
+private:
+	int inlineItems[INLINE_CAPACITY];
+	std::unique_ptr<int[]> spilled;  // heap buffer once the stack outgrows inlineItems
+	int* items;                      // inlineItems or spilled.get()
+	int capacity;
+	int itemCount;
+
+	void grow();
+public:
+	ArrayStack();
+	ArrayStack(const ArrayStack& aStack);
+	// Steals a spilled heap buffer; inline items are copied.
+	ArrayStack(ArrayStack&& aStack) noexcept;
+	// Reuses this stack's buffer when the copy fits in it.
+	ArrayStack& operator=(const ArrayStack& rhs);
+	ArrayStack& operator=(ArrayStack&& rhs) noexcept;
+
+	bool isEmpty() const;
+	int size() const;
+	bool push(const int& newItem);
+	bool pop();
+	// Precondition: !isEmpty().
+	int peek() const;
+	// Empties the stack but keeps any heap buffer for reuse.
+	void clear();
+	void display();
+};
+
+template<int INLINE_CAPACITY>
+ArrayStack<INLINE_CAPACITY>::ArrayStack()
+	: items(inlineItems), capacity(INLINE_CAPACITY), itemCount(0)
+{
+}
+
+template<int INLINE_CAPACITY>
+ArrayStack<INLINE_CAPACITY>::ArrayStack(const ArrayStack& aStack)
+	: items(inlineItems), capacity(INLINE_CAPACITY), itemCount(aStack.itemCount)
+{
+	if (itemCount > INLINE_CAPACITY)
+	{
+		capacity = aStack.capacity;
+		spilled.reset(new int[capacity]);
+		items = spilled.get();
+	}
+	std::copy(aStack.items, aStack.items + itemCount, items);
+}
+
+template<int INLINE_CAPACITY>
+ArrayStack<INLINE_CAPACITY>::ArrayStack(ArrayStack&& aStack) noexcept
+	: items(inlineItems), capacity(INLINE_CAPACITY), itemCount(0)
+{
+	*this = std::move(aStack);
+}
+
+template<int INLINE_CAPACITY>
+ArrayStack<INLINE_CAPACITY>& ArrayStack<INLINE_CAPACITY>::operator=(const ArrayStack& rhs)
+{
+	if (this != &rhs)
+	{
+		if (rhs.itemCount > capacity)
+		{
+			spilled.reset(new int[rhs.capacity]);
+			items = spilled.get();
+			capacity = rhs.capacity;
+		}
+		std::copy(rhs.items, rhs.items + rhs.itemCount, items);
+		itemCount = rhs.itemCount;
+	}
+	return *this;
+}  // end operator=
+
+template<int INLINE_CAPACITY>
+ArrayStack<INLINE_CAPACITY>& ArrayStack<INLINE_CAPACITY>::operator=(ArrayStack&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		if (rhs.spilled)
+		{
+			spilled = std::move(rhs.spilled);
+			items = spilled.get();
+			capacity = rhs.capacity;
+			rhs.items = rhs.inlineItems;
+			rhs.capacity = INLINE_CAPACITY;
+		}
+		else
+			// rhs holds at most INLINE_CAPACITY items, which always fit here.
+			std::copy(rhs.items, rhs.items + rhs.itemCount, items);
+		itemCount = rhs.itemCount;
+		rhs.itemCount = 0;
+	}
+	return *this;
+}  // end operator=
+
+template<int INLINE_CAPACITY>
+void ArrayStack<INLINE_CAPACITY>::grow()
+{
+	std::unique_ptr<int[]> larger(new int[2 * capacity]);
+	std::copy(items, items + itemCount, larger.get());
+	spilled = std::move(larger);
+	items = spilled.get();
+	capacity *= 2;
+}  // end grow
+
+template<int INLINE_CAPACITY>
+bool ArrayStack<INLINE_CAPACITY>::isEmpty() const
+{
+	return itemCount == 0;
+}
+
+template<int INLINE_CAPACITY>
+int ArrayStack<INLINE_CAPACITY>::size() const
+{
+	return itemCount;
+}
+
+template<int INLINE_CAPACITY>
+bool ArrayStack<INLINE_CAPACITY>::push(const int& newItem)
+{
+	if (itemCount == capacity)
+		grow();
+	items[itemCount++] = newItem;
+	return true;
+}  // end push
+
+template<int INLINE_CAPACITY>
+bool ArrayStack<INLINE_CAPACITY>::pop()
+{
+	if (isEmpty())
+		return false;
+	itemCount--;
+	return true;
+}  // end pop
+
+template<int INLINE_CAPACITY>
+int ArrayStack<INLINE_CAPACITY>::peek() const
+{
+	return items[itemCount - 1];
+}  // end peek
+
+template<int INLINE_CAPACITY>
+void ArrayStack<INLINE_CAPACITY>::clear()
+{
+	itemCount = 0;
+}  // end clear
+
+template<int INLINE_CAPACITY>
+void ArrayStack<INLINE_CAPACITY>::display()
+{
+	std::cout << "ArrayStack: '";
+	for (int i = itemCount - 1; i >= 0; i--)
+		std::cout << items[i];
+	std::cout << "'\n";
+}  // end display
+
+static_assert(std::is_nothrow_move_constructible<ArrayStack<>>::value, "ArrayStack moves must not throw");
+
+#endif
@@ -0,0 +1,117 @@
+// Allen Lim
+
+/** @file LinkedStack.cpp */
+
+#include "LinkedStack.h"
+#include <iostream>
+#include <utility>
+
+LinkedStack::LinkedStack() : topPtr(nullptr)
+{
+}
+
+LinkedStack::LinkedStack(const LinkedStack& aStack)
+{
+	Node* origChainPtr = aStack.topPtr;
+
+	if (origChainPtr == nullptr)
+		topPtr = nullptr;
+	else
+	{
+		topPtr = pool.create();
+		topPtr->setItem(origChainPtr->getItem());
+
+		Node* newChainPtr = topPtr;
+
+		origChainPtr = origChainPtr->getNext();
+
+		while (origChainPtr != nullptr)
+		{
+			int nextItem = origChainPtr->getItem();
+			Node* newNodePtr = pool.create(nextItem);
+			newChainPtr->setNext(newNodePtr);
+			newChainPtr = newChainPtr->getNext();
+			origChainPtr = origChainPtr->getNext();
+		}
+		newChainPtr->setNext(nullptr);
+	}
+}
+
+LinkedStack::LinkedStack(LinkedStack&& aStack) noexcept
+	: topPtr(aStack.topPtr), pool(std::move(aStack.pool))
+{
+	aStack.topPtr = nullptr;
+}
+
+LinkedStack& LinkedStack::operator=(const LinkedStack& rhs)
+{
+	if (&rhs != this)
+	{
+		LinkedStack copy(rhs);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+LinkedStack& LinkedStack::operator=(LinkedStack&& rhs) noexcept
+{
+	if (&rhs != this)
+	{
+		pool = std::move(rhs.pool);
+		topPtr = rhs.topPtr;
+		rhs.topPtr = nullptr;
+	}
+	return *this;
+}
+
+LinkedStack::~LinkedStack()
+{
+	// The nodes all live in pool's pages, which free in O(pages).
+	pool.release();
+	topPtr = nullptr;
+}
+
+bool LinkedStack::isEmpty() const
+{
+	return (topPtr == nullptr);
+}
+
+bool LinkedStack::push(const int& newEntry)
+{
+	Node* newNodePtr = pool.create(newEntry, topPtr);
+	topPtr = newNodePtr;
+	newNodePtr = nullptr;
+	return true;
+}
+
+bool LinkedStack::pop()
+{
+	bool result = false;
+	if (!isEmpty())
+	{
+		Node* nodeToDeletePtr = topPtr;
+		topPtr = topPtr->getNext();
+		nodeToDeletePtr->setNext(nullptr);
+		pool.destroy(nodeToDeletePtr);
+		nodeToDeletePtr = nullptr;
+
+		result = true;
+	}
+	return result;
+}
+
+int LinkedStack::peek()
+{
+	return topPtr->getItem();
+}
+
+void LinkedStack::display()
+{
+	Node * curr = topPtr;
+	std::cout << "LinkedStack: '";
+	while (curr != nullptr) {
+		std::cout << curr->getItem();
+		curr = curr->getNext();
+	}
+	std::cout << "'\n";
+}
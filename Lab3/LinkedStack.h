@@ -0,0 +1,38 @@
+// Allen Lim
+
+/** Stack of ints kept as a linked chain of Nodes.
+ @file LinkedStack.h */
+
+#ifndef LINKED_STACK_
+#define LINKED_STACK_
+
+#include <type_traits>
+#include "Node.h"
+#include "NodePool.h"
+
+class LinkedStack
+{
+
+private:
+	Node* topPtr;
+	NodePool<Node> pool;  // owns every node of the stack
+public:
+	LinkedStack();
+	LinkedStack(const LinkedStack& aStack);
+	// Moves take over aStack's nodes in O(1), leaving it empty.
+	LinkedStack(LinkedStack&& aStack) noexcept;
+	LinkedStack& operator=(const LinkedStack& rhs);
+	LinkedStack& operator=(LinkedStack&& rhs) noexcept;
+	virtual ~LinkedStack();
+
+	bool isEmpty() const;
+	bool push(const int& newItem);
+	bool pop();
+	int peek();
+	void display();
+};
+
+// Containers of stacks must move them when they grow, not copy them.
+static_assert(std::is_nothrow_move_constructible<LinkedStack>::value, "LinkedStack moves must not throw");
+
+#endif
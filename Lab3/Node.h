@@ -0,0 +1,25 @@
+// Allen Lim
+
+/** Singly linked node holding one int, for LinkedStack.
+ @file Node.h */
+
+#ifndef LAB3_NODE_
+#define LAB3_NODE_
+
+class Node
+{
+private:
+	int item;
+	Node* next;
+
+public:
+	Node();
+	Node(const int& anItem);
+	Node(const int& anItem, Node* nextNodePtr);
+	void setItem(const int& anItem);
+	void setNext(Node* nextNodePtr);
+	int getItem() const;
+	Node* getNext() const;
+};
+
+#endif
@@ -0,0 +1,157 @@
+// Allen Lim
+
+/** Postfix expression evaluation over a pluggable stack type.
+ @file Postfix.h */
+
+#ifndef POSTFIX_
+#define POSTFIX_
+
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "LinkedStack.h"
+#include "PostfixToken.h"
+
+// Evaluates a postfix expression of single-digit operands and + - * /,
+// e.g. "234+*" is 2 * (3 + 4); any other character throws
+// std::invalid_argument. StackType is LinkedStack, ArrayStack or
+// anything else with their push/pop/peek interface.
+template<class StackType = LinkedStack>
+int evalPostfix(const std::string& postfixstring)
+{
+	StackType stackInt;
+	int convertToInt;
+	for (std::size_t i = 0; i < postfixstring.length(); i++)
+	{
+		convertToInt = postfixstring[i] - '0';
+		if (convertToInt >= 0 && convertToInt <= 9)
+			stackInt.push(convertToInt);
+		else
+		{
+			int operand2 = stackInt.peek();
+			stackInt.pop();
+			int operand1 = stackInt.peek();
+			stackInt.pop();
+			int result;
+			switch (postfixstring[i])
+			{
+			case '+':
+				result = operand1 + operand2;
+				break;
+			case '-':
+				result = operand1 - operand2;
+				break;
+			case '*':
+				result = operand1 * operand2;
+				break;
+			case '/':
+				result = operand1 / operand2;
+				break;
+			default:
+				throw std::invalid_argument(std::string("evalPostfix: unknown operator '") + postfixstring[i] + "'");
+			}
+			stackInt.push(result);
+		}
+	}
+	return stackInt.peek();
+}
+
+// Outcome of evalPostfixTokens. Errors are status codes rather than
+// exceptions so that streams and batches with bad lines stay fast.
+enum class PostfixStatus
+{
+	Ok,
+	Empty,           // no tokens at all
+	BadToken,        // not an operator or an int literal that fits
+	MissingOperand,  // operator with fewer than two values on the stack
+	ExtraOperands,   // more than one value left at the end
+	DivideByZero,
+	Overflow         // INT_MIN / -1
+};
+
+inline const char* describe(PostfixStatus status)
+{
+	switch (status)
+	{
+	case PostfixStatus::Ok:
+		return "ok";
+	case PostfixStatus::Empty:
+		return "empty expression";
+	case PostfixStatus::BadToken:
+		return "bad token";
+	case PostfixStatus::MissingOperand:
+		return "operator needs two operands";
+	case PostfixStatus::ExtraOperands:
+		return "operands left without operators";
+	case PostfixStatus::DivideByZero:
+		return "division by zero";
+	case PostfixStatus::Overflow:
+		return "division overflows";
+	}
+	return "unknown error";
+}
+
+// Evaluates a postfix expression of int literals and + - * /, read with
+// the same token grammar as PostfixProgram (see PostfixToken.h), e.g.
+// "12 -3 4+ *"; names are bad tokens here, as nothing binds them. Works
+// on the text in place and allocates nothing beyond what stack itself
+// needs, so a stack reused across calls makes evaluation allocation-free.
+// + - * wrap like two's-complement ints. Sets result only when it
+// returns PostfixStatus::Ok. StackType needs ArrayStack's size() and
+// clear() as well as push/pop/peek.
+template<class StackType>
+PostfixStatus evalPostfixTokens(std::string_view expression, StackType& stack, int& result)
+{
+	stack.clear();
+	std::size_t position = 0;
+	for (PostfixToken token = nextPostfixToken(expression, position); token.kind != PostfixTokenKind::End;
+	     token = nextPostfixToken(expression, position))
+	{
+		if (token.kind == PostfixTokenKind::Number)
+		{
+			stack.push(token.value);
+			continue;
+		}
+		if (token.kind != PostfixTokenKind::Operator)
+			return PostfixStatus::BadToken;
+		if (stack.size() < 2)
+			return PostfixStatus::MissingOperand;
+		const int operand2 = stack.peek();
+		stack.pop();
+		const int operand1 = stack.peek();
+		stack.pop();
+		const unsigned left = static_cast<unsigned>(operand1);
+		const unsigned right = static_cast<unsigned>(operand2);
+		int value;
+		switch (token.value)
+		{
+		case '+':
+			value = static_cast<int>(left + right);
+			break;
+		case '-':
+			value = static_cast<int>(left - right);
+			break;
+		case '*':
+			value = static_cast<int>(left * right);
+			break;
+		default:
+			if (operand2 == 0)
+				return PostfixStatus::DivideByZero;
+			if (operand2 == -1 && operand1 == INT_MIN)
+				return PostfixStatus::Overflow;
+			value = operand1 / operand2;
+			break;
+		}
+		stack.push(value);
+	}
+	if (stack.isEmpty())
+		return PostfixStatus::Empty;
+	if (stack.size() > 1)
+		return PostfixStatus::ExtraOperands;
+	result = stack.peek();
+	return PostfixStatus::Ok;
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Allen Lim
+
+/** @file PostfixBatch.cpp */
+
+#include "PostfixBatch.h"
+#include "ArrayStack.h"
+
+void evalPostfixBatch(const std::string_view expressions[], std::size_t count, PostfixResult results[],
+                      const PostfixBatchOptions& options)
+{
+	const std::size_t chunkSize = (options.chunkSize > 0) ? static_cast<std::size_t>(options.chunkSize) : 1;
+	const std::size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+	// Chunks of 4096 results span many cache lines, so neighbouring
+	// workers rarely write to the same line.
+	ThreadPool::of(options).parallelFor(0, chunks, options.threadCount, [&](std::size_t c)
+	{
+		ArrayStack<> stack;
+		const std::size_t end = (c + 1 < chunks) ? (c + 1) * chunkSize : count;
+		for (std::size_t i = c * chunkSize; i < end; i++)
+		{
+			int value = 0;
+			results[i].status = evalPostfixTokens(expressions[i], stack, value);
+			results[i].value = value;
+		}
+	});
+}
+
+std::vector<PostfixResult> evalPostfixBatch(const std::vector<std::string_view>& expressions,
+                                            const PostfixBatchOptions& options)
+{
+	std::vector<PostfixResult> results(expressions.size());
+	evalPostfixBatch(expressions.data(), expressions.size(), results.data(), options);
+	return results;
+}
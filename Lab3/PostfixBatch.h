@@ -0,0 +1,41 @@
+// Allen Lim
+
+/** Parallel evaluation of large batches of independent postfix
+ expressions. Threads take chunks of the batch in turn through
+ ThreadPool::parallelFor and write each result to the slot matching its
+ expression, so results come back in input order with no merging step.
+ @file PostfixBatch.h */
+
+#ifndef POSTFIX_BATCH_
+#define POSTFIX_BATCH_
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+#include "Postfix.h"
+#include "ThreadPool.h"
+
+struct PostfixResult
+{
+	PostfixStatus status;
+	int value;  // meaningful only when status is PostfixStatus::Ok
+};
+
+// ParallelOptions plus how many expressions a worker takes at a time.
+struct PostfixBatchOptions : ParallelOptions
+{
+	int chunkSize = 4096;
+};
+
+// Evaluates expressions[i] with evalPostfixTokens into results[i] for
+// every i < count. Each chunk is evaluated on its own ArrayStack, whose
+// inline buffer covers shallow expressions without touching the heap, and
+// writes only its own slots of results, so threads share no allocation
+// and no lock; the expressions' text must stay alive until the call returns.
+void evalPostfixBatch(const std::string_view expressions[], std::size_t count, PostfixResult results[],
+                      const PostfixBatchOptions& options = PostfixBatchOptions());
+
+std::vector<PostfixResult> evalPostfixBatch(const std::vector<std::string_view>& expressions,
+                                            const PostfixBatchOptions& options = PostfixBatchOptions());
+
+#endif
@@ -0,0 +1,221 @@
+// Allen Lim
+
+/** @file PostfixProgram.cpp */
+
+#include "PostfixProgram.h"
+#include "PostfixToken.h"
+#include <climits>
+#include <stdexcept>
+
+namespace
+{
+
+// Two's-complement wrap-around without signed overflow.
+inline int wrap(unsigned value)
+{
+	return static_cast<int>(value);
+}
+
+inline int divide(int dividend, int divisor)
+{
+	if (divisor == 0)
+		throw std::domain_error("PostfixProgram: division by zero");
+	if (divisor == -1 && dividend == INT_MIN)
+		throw std::domain_error("PostfixProgram: INT_MIN / -1 overflows");
+	return dividend / divisor;
+}
+
+const int INLINE_STACK = 64;
+
+}  // end namespace
+
+PostfixProgram::PostfixProgram(std::string_view expression) : depth(0)
+{
+	int height = 0;
+	std::size_t position = 0;
+	for (PostfixToken token = nextPostfixToken(expression, position); token.kind != PostfixTokenKind::End;
+	     token = nextPostfixToken(expression, position))
+	{
+		Instruction push;
+		switch (token.kind)
+		{
+		case PostfixTokenKind::Operator:
+			if (height < 2)
+				throw std::invalid_argument("PostfixProgram: operator '" + std::string(token.text) + "' needs two operands");
+			emitOperator(static_cast<char>(token.value));
+			height--;
+			continue;
+		case PostfixTokenKind::Number:
+			push.op = PushConst;
+			push.operand = token.value;
+			break;
+		case PostfixTokenKind::Name:
+		{
+			const std::string name(token.text);
+			int slot = variableSlot(name);
+			if (slot < 0)
+			{
+				slot = static_cast<int>(variables.size());
+				variables.push_back(name);
+			}
+			push.op = PushVar;
+			push.operand = slot;
+			break;
+		}
+		case PostfixTokenKind::OutOfRange:
+			throw std::invalid_argument("PostfixProgram: literal " + std::string(token.text) + " out of range");
+		default:
+			throw std::invalid_argument("PostfixProgram: bad token '" + std::string(token.text) + "'");
+		}
+		code.push_back(push);
+		if (++height > depth)
+			depth = height;
+	}
+	if (height != 1)
+		throw std::invalid_argument(height == 0 ? "PostfixProgram: empty expression"
+		                                        : "PostfixProgram: operands left without operators");
+	Instruction halt;
+	halt.op = Halt;
+	halt.operand = 0;
+	code.push_back(halt);
+}
+
+// Appends the operator, folding it into a preceding push of its right
+// operand when there is one.
+void PostfixProgram::emitOperator(char symbol)
+{
+	const int offset = (symbol == '+') ? 0 : (symbol == '-') ? 1 : (symbol == '*') ? 2 : 3;
+	Instruction& last = code.back();
+	if (last.op == PushConst)
+		last.op = static_cast<OpCode>(AddConst + offset);
+	else if (last.op == PushVar)
+		last.op = static_cast<OpCode>(AddVar + offset);
+	else
+	{
+		Instruction instruction;
+		instruction.op = static_cast<OpCode>(Add + offset);
+		instruction.operand = 0;
+		code.push_back(instruction);
+	}
+}
+
+int PostfixProgram::variableCount() const
+{
+	return static_cast<int>(variables.size());
+}
+
+const std::string& PostfixProgram::variableName(int slot) const
+{
+	return variables[slot];
+}
+
+int PostfixProgram::variableSlot(const std::string& name) const
+{
+	for (std::size_t slot = 0; slot < variables.size(); slot++)
+		if (variables[slot] == name)
+			return static_cast<int>(slot);
+	return -1;
+}
+
+int PostfixProgram::size() const
+{
+	return static_cast<int>(code.size());
+}
+
+int PostfixProgram::maxDepth() const
+{
+	return depth;
+}
+
+int PostfixProgram::evaluate(const int values[]) const
+{
+	if (depth <= INLINE_STACK)
+	{
+		int stack[INLINE_STACK];
+		return run(values, stack);
+	}
+	std::vector<int> stack(depth);
+	return run(values, stack.data());
+}
+
+// The compiler has already checked the stack never underflows and never
+// grows past depth, so the loop does no bounds checks. GCC and Clang
+// dispatch through a table of label addresses (one indirect jump per
+// instruction, each predicted separately); other compilers use a switch.
+int PostfixProgram::run(const int values[], int stack[]) const
+{
+	const Instruction* pc = code.data();
+	int* top = stack - 1;  // the top item; stack is empty when top < stack
+
+#if defined(__GNUC__) || defined(__clang__)
+	static const void* const handlers[] = {
+		&&op_Halt,
+		&&op_PushConst, &&op_PushVar,
+		&&op_Add, &&op_Sub, &&op_Mul, &&op_Div,
+		&&op_AddConst, &&op_SubConst, &&op_MulConst, &&op_DivConst,
+		&&op_AddVar, &&op_SubVar, &&op_MulVar, &&op_DivVar
+	};
+#define CASE(name) op_##name:
+#define NEXT goto *handlers[(++pc)->op]
+	goto *handlers[pc->op];
+#else
+#define CASE(name) case name:
+#define NEXT pc++; continue
+	for (;;)
+	switch (pc->op)
+	{
+#endif
+	CASE(PushConst)
+		*++top = pc->operand;
+		NEXT;
+	CASE(PushVar)
+		*++top = values[pc->operand];
+		NEXT;
+	CASE(Add)
+		top--;
+		*top = wrap(static_cast<unsigned>(*top) + static_cast<unsigned>(top[1]));
+		NEXT;
+	CASE(Sub)
+		top--;
+		*top = wrap(static_cast<unsigned>(*top) - static_cast<unsigned>(top[1]));
+		NEXT;
+	CASE(Mul)
+		top--;
+		*top = wrap(static_cast<unsigned>(*top) * static_cast<unsigned>(top[1]));
+		NEXT;
+	CASE(Div)
+		top--;
+		*top = divide(*top, top[1]);
+		NEXT;
+	CASE(AddConst)
+		*top = wrap(static_cast<unsigned>(*top) + static_cast<unsigned>(pc->operand));
+		NEXT;
+	CASE(SubConst)
+		*top = wrap(static_cast<unsigned>(*top) - static_cast<unsigned>(pc->operand));
+		NEXT;
+	CASE(MulConst)
+		*top = wrap(static_cast<unsigned>(*top) * static_cast<unsigned>(pc->operand));
+		NEXT;
+	CASE(DivConst)
+		*top = divide(*top, pc->operand);
+		NEXT;
+	CASE(AddVar)
+		*top = wrap(static_cast<unsigned>(*top) + static_cast<unsigned>(values[pc->operand]));
+		NEXT;
+	CASE(SubVar)
+		*top = wrap(static_cast<unsigned>(*top) - static_cast<unsigned>(values[pc->operand]));
+		NEXT;
+	CASE(MulVar)
+		*top = wrap(static_cast<unsigned>(*top) * static_cast<unsigned>(values[pc->operand]));
+		NEXT;
+	CASE(DivVar)
+		*top = divide(*top, values[pc->operand]);
+		NEXT;
+	CASE(Halt)
+		return *top;
+#if !(defined(__GNUC__) || defined(__clang__))
+	}
+#endif
+#undef CASE
+#undef NEXT
+}
@@ -0,0 +1,71 @@
+// Allen Lim
+
+/** PostfixProgram: a postfix expression compiled once into bytecode and
+ then evaluated many times, with different variable values, without
+ parsing the text again.
+
+ Tokens follow PostfixToken.h, the grammar evalPostfixTokens reads too:
+ int literals, variable names and the operators + - * /. So "x 3 * y +"
+ is x * 3 + y. Unlike evalPostfix, a run of digits is one number: "12+"
+ is a single operand and an error.
+ @file PostfixProgram.h */
+
+#ifndef POSTFIX_PROGRAM_
+#define POSTFIX_PROGRAM_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class PostfixProgram
+{
+public:
+	// Throws std::invalid_argument if expression is not a well-formed
+	// postfix expression: an unknown token, an out-of-range literal, an
+	// operator without two operands, or not exactly one value left.
+	explicit PostfixProgram(std::string_view expression);
+
+	// Variables in order of first appearance; values passed to evaluate
+	// are indexed the same way.
+	int variableCount() const;
+	const std::string& variableName(int slot) const;
+	// Slot of the named variable, or -1.
+	int variableSlot(const std::string& name) const;
+
+	// Runs the program with values[slot] for each variable (values may be
+	// nullptr when there are none). + - * wrap around on overflow like
+	// two's-complement ints; throws std::domain_error on division by zero
+	// and on INT_MIN / -1.
+	int evaluate(const int values[] = nullptr) const;
+
+	// Number of instructions and the deepest the stack gets.
+	int size() const;
+	int maxDepth() const;
+private:
+	// Binary operators also come fused with a constant or variable right
+	// operand (push then operate), which halves the dispatches of typical
+	// expressions such as "a 2 * b + c -".
+	enum OpCode : std::uint8_t
+	{
+		Halt,
+		PushConst, PushVar,
+		Add, Sub, Mul, Div,
+		AddConst, SubConst, MulConst, DivConst,
+		AddVar, SubVar, MulVar, DivVar
+	};
+	struct Instruction
+	{
+		OpCode op;
+		int operand;  // the constant or variable slot, if any
+	};
+
+	std::vector<Instruction> code;
+	std::vector<std::string> variables;
+	int depth;
+
+	void emitOperator(char symbol);
+	int run(const int values[], int stack[]) const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+// Allen Lim
+
+/** @file PostfixStream.cpp */
+
+#include "PostfixStream.h"
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ArrayStack.h"
+#include "Postfix.h"
+
+namespace
+{
+
+const std::size_t BLOCK_SIZE = 1 << 20;
+
+void writeResult(std::string_view line, ArrayStack<>& stack, std::string& output, StreamTotals& totals)
+{
+	int result;
+	const PostfixStatus status = evalPostfixTokens(line, stack, result);
+	if (status == PostfixStatus::Empty)
+	{
+		output += '\n';
+		return;
+	}
+	totals.expressions++;
+	if (status == PostfixStatus::Ok)
+	{
+		char digits[16];
+		const std::to_chars_result written = std::to_chars(digits, digits + sizeof(digits), result);
+		output.append(digits, written.ptr);
+	}
+	else
+	{
+		totals.errors++;
+		output += "error: ";
+		output += describe(status);
+	}
+	output += '\n';
+}
+
+}  // end namespace
+
+StreamTotals evalPostfixStream(std::istream& in, std::ostream& out)
+{
+	StreamTotals totals = { 0, 0, 0, 0 };
+	ArrayStack<> stack;
+	std::vector<char> buffer(BLOCK_SIZE);
+	std::string output;
+	output.reserve(BLOCK_SIZE + 64);
+
+	// buffer[0, kept) is the unfinished last line of the previous block.
+	std::size_t kept = 0;
+	for (;;)
+	{
+		if (kept == buffer.size())
+			buffer.resize(2 * buffer.size());  // one line longer than a block
+		in.read(buffer.data() + kept, static_cast<std::streamsize>(buffer.size() - kept));
+		const std::size_t got = static_cast<std::size_t>(in.gcount());
+		totals.bytes += static_cast<long long>(got);
+		const std::size_t filled = kept + got;
+		if (got == 0)
+		{
+			// A last line without a newline.
+			if (kept > 0)
+			{
+				totals.lines++;
+				writeResult(std::string_view(buffer.data(), kept), stack, output, totals);
+			}
+			break;
+		}
+
+		const char* lineStart = buffer.data();
+		const char* blockEnd = buffer.data() + filled;
+		const char* newline;
+		while ((newline = static_cast<const char*>(std::memchr(lineStart, '\n', blockEnd - lineStart))) != nullptr)
+		{
+			totals.lines++;
+			writeResult(std::string_view(lineStart, newline - lineStart), stack, output, totals);
+			lineStart = newline + 1;
+			if (output.size() >= BLOCK_SIZE)
+			{
+				out.write(output.data(), static_cast<std::streamsize>(output.size()));
+				output.clear();
+			}
+		}
+		kept = static_cast<std::size_t>(blockEnd - lineStart);
+		std::memmove(buffer.data(), lineStart, kept);
+	}
+	out.write(output.data(), static_cast<std::streamsize>(output.size()));
+	out.flush();
+	return totals;
+}
@@ -0,0 +1,28 @@
+// Allen Lim
+
+/** Streaming evaluation of newline-delimited postfix expressions, for
+ pushing large expression logs through evalPostfixTokens.
+ @file PostfixStream.h */
+
+#ifndef POSTFIX_STREAM_
+#define POSTFIX_STREAM_
+
+#include <iostream>
+
+struct StreamTotals
+{
+	long long lines;        // input lines, blank ones included
+	long long expressions;  // non-blank lines, evaluated or not
+	long long errors;       // expressions that failed
+	long long bytes;        // input bytes read
+};
+
+// Reads in to the end, one expression per line (see evalPostfixTokens),
+// and writes one line to out for each input line: the value, "error: "
+// and the reason, or nothing for a blank line. A bad line never stops
+// the stream. Input is read and output written in blocks of about 1 MiB;
+// lines are tokenized in place, so apart from those two buffers (and a
+// line that does not fit in one block) nothing is allocated per line.
+StreamTotals evalPostfixStream(std::istream& in, std::ostream& out);
+
+#endif
@@ -0,0 +1,112 @@
+// Allen Lim
+
+/** The token grammar shared by PostfixProgram and evalPostfixTokens.
+
+ Tokens are separated by whitespace or stand next to an operator: int
+ literals ("42", "-7"), names ("x", "rate_2") and the operators + - * /.
+ A '-' directly before a digit starts a negative literal, so "12 3*" and
+ "12 3 *" both read 12, 3, *, while "12 3 -4" reads three literals. A run
+ of digits is one number, and an operand running straight into anything
+ but whitespace or an operator ("3x") is a bad token.
+ @file PostfixToken.h */
+
+#ifndef POSTFIX_TOKEN_
+#define POSTFIX_TOKEN_
+
+#include <climits>
+#include <cstddef>
+#include <string_view>
+
+enum class PostfixTokenKind
+{
+	End,         // no tokens left
+	Number,      // value holds the literal
+	Name,
+	Operator,    // value holds the operator character
+	OutOfRange,  // a literal that does not fit in an int
+	BadToken
+};
+
+struct PostfixToken
+{
+	PostfixTokenKind kind;
+	std::string_view text;
+	int value;
+};
+
+inline bool isPostfixSpace(char ch)
+{
+	return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+inline bool isPostfixOperator(char ch)
+{
+	return ch == '+' || ch == '-' || ch == '*' || ch == '/';
+}
+
+// Reads the token at or after position in expression and moves position
+// past it. Works on the text in place and never allocates.
+inline PostfixToken nextPostfixToken(std::string_view expression, std::size_t& position)
+{
+	const std::size_t size = expression.size();
+	while (position < size && isPostfixSpace(expression[position]))
+		position++;
+	const std::size_t start = position;
+	PostfixToken token;
+	token.value = 0;
+	if (position == size)
+	{
+		token.kind = PostfixTokenKind::End;
+		return token;
+	}
+
+	auto isDigit = [](char ch) { return ch >= '0' && ch <= '9'; };
+	auto isNameChar = [](char ch) { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_'; };
+	const char ch = expression[position];
+	if (isPostfixOperator(ch) && !(ch == '-' && position + 1 < size && isDigit(expression[position + 1])))
+	{
+		position++;
+		token.kind = PostfixTokenKind::Operator;
+		token.text = expression.substr(start, 1);
+		token.value = ch;
+		return token;
+	}
+
+	if (ch == '-' || isDigit(ch))
+	{
+		const bool negative = (ch == '-');
+		const long long limit = static_cast<long long>(INT_MAX) + (negative ? 1 : 0);
+		long long value = 0;
+		token.kind = PostfixTokenKind::Number;
+		for (position += negative ? 1 : 0; position < size && isDigit(expression[position]); position++)
+		{
+			value = value * 10 + (expression[position] - '0');
+			if (value > limit)
+			{
+				token.kind = PostfixTokenKind::OutOfRange;
+				value = 0;
+			}
+		}
+		token.value = static_cast<int>(negative ? -value : value);
+	}
+	else if (isNameChar(ch))
+	{
+		token.kind = PostfixTokenKind::Name;
+		while (position < size && (isNameChar(expression[position]) || isDigit(expression[position])))
+			position++;
+	}
+	else
+		token.kind = PostfixTokenKind::BadToken;
+
+	// Operands end at whitespace, an operator or the end of the text.
+	if (position < size && !isPostfixSpace(expression[position]) && !isPostfixOperator(expression[position]))
+	{
+		token.kind = PostfixTokenKind::BadToken;
+		while (position < size && !isPostfixSpace(expression[position]) && !isPostfixOperator(expression[position]))
+			position++;
+	}
+	token.text = expression.substr(start, position - start);
+	return token;
+}
+
+#endif
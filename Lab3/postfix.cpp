@@ -1,198 +1,57 @@
 // Allen Lim
 
-#include<iostream>
-#include<string>
-
-class Node
-{
-private:
-	int item;
-	Node* next;
-
-public:
-	Node();
-	Node(const int& anItem);
-	Node(const int& anItem, Node* nextNodePtr);
-	void setItem(const int& anItem);
-	void setNext(Node* nextNodePtr);
-	int getItem() const;
-	Node* getNext() const;
-};
-
-
-Node::Node() : next(nullptr)
-{
-}
-
-Node::Node(const int& anItem) : item(anItem), next(nullptr)
-{
-}
-
-Node::Node(const int& anItem, Node* nextNodePtr) :
-	item(anItem), next(nextNodePtr)
-{
-}
-
-void Node::setItem(const int& anItem)
-{
-	item = anItem;
-}
-
-void Node::setNext(Node* nextNodePtr)
-{
-	next = nextNodePtr;
-}
-
-int Node::getItem() const
-{
-	return item;
-}
-
-Node* Node::getNext() const
-{
-	return next;
-}
+/** usage: postfix_exe [file | -]
 
+ With no argument, evaluates a few sample expressions. Given a file, or
+ - for standard input, evaluates one expression per line, writes one
+ result per line to standard output and reports throughput on standard
+ error.
+ @file postfix.cpp */
 
-class LinkedStack
-{
-
-private:
-	Node* topPtr;
-public:
-	LinkedStack();
-	LinkedStack(const LinkedStack& aStack);
-	virtual ~LinkedStack();
-
-	bool isEmpty() const;
-	bool push(const int& newItem);
-	bool pop();
-	int peek();
-	void display();
-};
-
-
-LinkedStack::LinkedStack() : topPtr(nullptr)
-{
-}
+#include<chrono>
+#include<cstdio>
+#include<fstream>
+#include<iostream>
+#include<string>
+#include "Postfix.h"
+#include "PostfixStream.h"
 
-LinkedStack::LinkedStack(const LinkedStack& aStack)
+int streamMain(const char* path)
 {
-	Node* origChainPtr = aStack.topPtr;
-
-	if (origChainPtr == nullptr)
-		topPtr = nullptr;
-	else
+	std::ios::sync_with_stdio(false);
+	std::ifstream file;
+	if (std::string(path) != "-")
 	{
-		topPtr = new Node();
-		topPtr->setItem(origChainPtr->getItem());
-
-		Node* newChainPtr = topPtr;
-
-		origChainPtr = origChainPtr->getNext();
-
-		while (origChainPtr != nullptr)
+		file.open(path, std::ios::binary);
+		if (!file)
 		{
-			int nextItem = origChainPtr->getItem();
-			Node* newNodePtr = new Node(nextItem);
-			newChainPtr->setNext(newNodePtr);
-			newChainPtr = newChainPtr->getNext();
-			origChainPtr = origChainPtr->getNext();
+			std::cerr << "postfix_exe: cannot open " << path << "\n";
+			return 1;
 		}
-		newChainPtr->setNext(nullptr);
 	}
-}
-
-LinkedStack::~LinkedStack()
-{
-	while (!isEmpty())
-		pop();
-}
-
-bool LinkedStack::isEmpty() const
-{
-	return (topPtr == nullptr);
-}
-
-bool LinkedStack::push(const int& newEntry)
-{
-	Node* newNodePtr = new Node(newEntry, topPtr);
-	topPtr = newNodePtr;
-	newNodePtr = nullptr;
-	return true;
-}
-
-bool LinkedStack::pop()
-{
-	bool result = false;
-	if (!isEmpty())
+	std::istream& in = file.is_open() ? static_cast<std::istream&>(file) : std::cin;
+
+	using Clock = std::chrono::steady_clock;
+	Clock::time_point start = Clock::now();
+	StreamTotals totals = evalPostfixStream(in, std::cout);
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	if (seconds <= 0)
+		seconds = 1e-9;
+	std::fprintf(stderr, "%lld expressions (%lld errors) in %.3f s: %.0f expressions/s, %.1f MB/s\n",
+	             totals.expressions, totals.errors, seconds, totals.expressions / seconds, totals.bytes / seconds / 1e6);
+	return (in.bad() || !std::cout) ? 1 : 0;
+}  // end streamMain
+
+int main(int argc, char* argv[])
+{
+	if (argc > 2)
 	{
-		Node* nodeToDeletePtr = topPtr;
-		topPtr = topPtr->getNext();
-		nodeToDeletePtr->setNext(nullptr);
-		delete nodeToDeletePtr;
-		nodeToDeletePtr = nullptr;
-
-		result = true;
+		std::cerr << "usage: " << argv[0] << " [file | -]\n";
+		return 1;
 	}
-	return result;
-}
+	if (argc == 2)
+		return streamMain(argv[1]);
 
-int LinkedStack::peek()
-{
-	return topPtr->getItem();
-}
-
-void LinkedStack::display()
-{
-	Node * curr = topPtr;
-	std::cout << "LinkedStack: '";
-	while (curr != nullptr) {
-		std::cout << curr->getItem();
-		curr = curr->getNext();
-	}
-	std::cout << "'\n";
-}
-
-int evalPostfix(std::string postfixstring)
-{
-	LinkedStack stackInt;
-	int convertToInt;
-	for (int i = 0; i < postfixstring.length(); i++)
-	{
-		convertToInt = postfixstring[i] - '0';
-		if (convertToInt >= 0 && convertToInt <= 9)
-			stackInt.push(convertToInt);
-		else
-		{
-			int operand2 = stackInt.peek();
-			stackInt.pop();
-			int operand1 = stackInt.peek();
-			stackInt.pop();
-			int result;
-			switch (postfixstring[i])
-			{
-			case '+':
-				result = operand1 + operand2;
-				break;
-			case '-':
-				result = operand1 - operand2;
-				break;
-			case '*':
-				result = operand1 * operand2;
-				break;
-			case '/':
-				result = operand1 / operand2;
-				break;
-			}
-			stackInt.push(result);
-		}
-	}
-	return stackInt.peek();
-}
-
-int main()
-{
 	LinkedStack ls;
 	std::string string1("234+*");
 	int convertToInt;
@@ -204,4 +63,4 @@ int main()
 	string1 = "12*34*+";
 	std::cout << string1 << " = " << evalPostfix(string1) << "\n\n";
 	return 0;
-}
\ No newline at end of file
+}
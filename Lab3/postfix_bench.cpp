@@ -0,0 +1,154 @@
+// Allen Lim
+
+/** Benchmarks evalPostfix over LinkedStack against ArrayStack, and both
+ against the same expressions compiled once into PostfixPrograms; then
+ evalPostfixBatch on 1, 2, 4 and one thread per pool worker.
+
+ usage: postfix_bench [--count N]
+
+ Each family is a batch of N expressions evaluated one after another;
+ ns/expr is the fastest of a few runs over the batch. The deep family
+ nests past ArrayStack's inline capacity, so it also covers the spill.
+ The compiled column leaves out compilation, which happens once; the
+ bindings section then reruns one program over N sets of variable values.
+ @file postfix_bench.cpp */
+
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+#include "ArrayStack.h"
+#include "Bench.h"
+#include "LinkedStack.h"
+#include "Postfix.h"
+#include "PostfixBatch.h"
+#include "PostfixProgram.h"
+
+// operands digits combined left to right with operators drawn from ops:
+// stack depth stays at 2.
+std::string leftDeep(std::mt19937& generator, int operands, const std::string& ops)
+{
+	std::string expression(1, static_cast<char>('1' + generator() % 9));
+	for (int i = 1; i < operands; i++)
+	{
+		expression += static_cast<char>('1' + generator() % 9);
+		expression += ops[generator() % ops.size()];
+	}
+	return expression;
+}  // end leftDeep
+
+// All operands first, then all operators: stack depth reaches operands.
+std::string rightDeep(std::mt19937& generator, int operands)
+{
+	std::string expression;
+	for (int i = 0; i < operands; i++)
+		expression += static_cast<char>('1' + generator() % 9);
+	for (int i = 1; i < operands; i++)
+		expression += "+-"[generator() % 2];
+	return expression;
+}  // end rightDeep
+
+// The same expression with a space between tokens, as PostfixProgram
+// reads consecutive digits as one number.
+std::string spaced(const std::string& expression)
+{
+	std::string result;
+	for (char ch : expression)
+	{
+		if (!result.empty())
+			result += ' ';
+		result += ch;
+	}
+	return result;
+}  // end spaced
+
+int main(int argc, char* argv[])
+{
+	int count = 100000;
+	if (!BenchArgs().option("--count", "N", count).parse(argc, argv))
+		return 1;
+
+	struct Family
+	{
+		const char* name;
+		std::function<std::string(std::mt19937&)> make;
+	};
+	Family families[] = {
+		{ "short (3 ops)", [](std::mt19937& g) { return leftDeep(g, 4, "+-*"); } },
+		// No * so the running value cannot overflow.
+		{ "long (31 ops)", [](std::mt19937& g) { return leftDeep(g, 32, "+-"); } },
+		{ "nested 16", [](std::mt19937& g) { return rightDeep(g, 16); } },
+		{ "nested 64", [](std::mt19937& g) { return rightDeep(g, 64); } },
+	};
+
+	std::printf("%-15s %14s %14s %8s %16s %8s\n", "family", "linked ns/expr", "array ns/expr", "speedup",
+	            "compiled ns/expr", "speedup");
+	for (const Family& family : families)
+	{
+		std::mt19937 generator(1);
+		std::vector<std::string> batch;
+		std::vector<PostfixProgram> programs;
+		for (int i = 0; i < count; i++)
+		{
+			batch.push_back(family.make(generator));
+			programs.emplace_back(spaced(batch.back()));
+		}
+
+		volatile int sink = 0;
+		double linked = bestTime([&]
+		{
+			for (const std::string& expression : batch)
+				sink = sink + evalPostfix<LinkedStack>(expression);
+		}, 5);
+		double array = bestTime([&]
+		{
+			for (const std::string& expression : batch)
+				sink = sink + evalPostfix<ArrayStack<>>(expression);
+		}, 5);
+		double compiled = bestTime([&]
+		{
+			for (const PostfixProgram& program : programs)
+				sink = sink + program.evaluate();
+		}, 5);
+		std::printf("%-15s %14.1f %14.1f %7.2fx %16.1f %7.2fx\n", family.name, linked * 1e9 / count, array * 1e9 / count,
+		            linked / array, compiled * 1e9 / count, linked / compiled);
+	}
+
+	// One program, many bindings: the text is parsed once in total.
+	const char* formula = "x 3 * y + 2 - z /";
+	PostfixProgram program(formula);
+	std::mt19937 generator(1);
+	std::vector<int> bindings;
+	for (int i = 0; i < 3 * count; i++)
+		bindings.push_back(static_cast<int>(generator() % 1000) + 1);
+	volatile int sink = 0;
+	double bound = bestTime([&]
+	{
+		for (int i = 0; i < count; i++)
+			sink = sink + program.evaluate(&bindings[3 * static_cast<std::size_t>(i)]);
+	}, 5);
+	std::printf("\nbindings: \"%s\" (%d instructions) %.1f ns/evaluation\n", formula, program.size(), bound * 1e9 / count);
+
+	// Batch of the short and long families, ten times over.
+	std::vector<std::string> texts;
+	std::mt19937 batchGenerator(1);
+	for (int i = 0; i < 10 * count; i++)
+		texts.push_back(spaced(leftDeep(batchGenerator, (i % 2 == 0) ? 4 : 32, "+-")));
+	std::vector<std::string_view> views(texts.begin(), texts.end());
+	std::vector<PostfixResult> results(views.size());
+
+	std::printf("\n%-8s %12s %8s\n", "threads", "ns/expr", "speedup");
+	const unsigned poolSize = ThreadPool::shared().size();
+	double single = 0;
+	for (unsigned threads : { 1u, 2u, 4u, poolSize })
+	{
+		PostfixBatchOptions options;
+		options.threadCount = threads;
+		double batch = bestTime([&] { evalPostfixBatch(views.data(), views.size(), results.data(), options); }, 5);
+		if (threads == 1)
+			single = batch;
+		std::printf("%-8u %12.2f %7.2fx\n", threads, batch * 1e9 / views.size(), single / batch);
+	}
+	return 0;
+}
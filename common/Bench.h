@@ -0,0 +1,93 @@
+// Allen Lim
+
+/** Timing and command-line helpers shared by the labs' benchmarks.
+ @file Bench.h */
+
+#ifndef BENCH_
+#define BENCH_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Runs work at least runs times and until minSeconds have passed in
+// total, and returns the fastest run in seconds.
+inline double bestTime(const std::function<void()>& work, int runs = 3, double minSeconds = 0)
+{
+	using Clock = std::chrono::steady_clock;
+	double best = 1e300;
+	double total = 0;
+	for (int run = 0; run < runs || total < minSeconds; run++)
+	{
+		Clock::time_point start = Clock::now();
+		work();
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		best = std::min(best, seconds);
+		total += seconds;
+	}
+	return best;
+}  // end bestTime
+
+// A benchmark's command line: "--name VALUE" options and "--name" flags
+// registered up front, from which parse() also builds the usage line.
+class BenchArgs
+{
+private:
+	struct Option
+	{
+		const char* name;
+		const char* valueName;  // nullptr for a flag
+		std::function<void(const char*)> set;
+	};
+	std::vector<Option> options;
+public:
+	// Numbers are read with strtod, so "1e7" works for sizes too.
+	template<class NumberType>
+	BenchArgs& option(const char* name, const char* valueName, NumberType& value);
+	BenchArgs& flag(const char* name, bool& value);
+
+	// Sets the registered variables from argv. Prints the usage line to
+	// std::cerr and returns false on anything it does not recognize.
+	bool parse(int argc, char* argv[]) const;
+};
+
+template<class NumberType>
+BenchArgs& BenchArgs::option(const char* name, const char* valueName, NumberType& value)
+{
+	options.push_back({ name, valueName, [&value](const char* text) { value = static_cast<NumberType>(std::strtod(text, nullptr)); } });
+	return *this;
+}
+
+inline BenchArgs& BenchArgs::flag(const char* name, bool& value)
+{
+	options.push_back({ name, nullptr, [&value](const char*) { value = true; } });
+	return *this;
+}
+
+inline bool BenchArgs::parse(int argc, char* argv[]) const
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const Option* match = nullptr;
+		for (const Option& option : options)
+			if (std::strcmp(argv[i], option.name) == 0 && (option.valueName == nullptr || i + 1 < argc))
+				match = &option;
+		if (match == nullptr)
+		{
+			std::string usage = std::string("usage: ") + argv[0];
+			for (const Option& option : options)
+				usage += std::string(" [") + option.name + (option.valueName ? std::string(" ") + option.valueName : "") + "]";
+			std::cerr << usage << "\n";
+			return false;
+		}
+		match->set(match->valueName ? argv[++i] : nullptr);
+	}
+	return true;
+}  // end parse
+
+#endif
@@ -0,0 +1,243 @@
+// Allen Lim
+
+/** NodePool: slab allocator for linked-structure nodes. Nodes come from
+ large contiguous pages that grow geometrically; destroyed nodes go on a
+ free list and are reused before the current page is touched again.
+ release() frees every node at once in O(pages) without visiting them.
+ Pools move but do not copy. Used by Lab2's LinkedChar and Lab3's
+ LinkedStack.
+ @file NodePool.h */
+
+#ifndef NODE_POOL_
+#define NODE_POOL_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template<class NodeType>
+class NodePool
+{
+	// release() drops nodes without running their destructors.
+	static_assert(std::is_trivially_destructible<NodeType>::value,
+	              "NodePool nodes must be trivially destructible");
+public:
+	static const std::size_t FIRST_PAGE_NODES = 16;
+	static const std::size_t MAX_PAGE_BYTES = std::size_t(1) << 20;
+
+	NodePool();
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+	// Both take over other's nodes in O(1), leaving other empty;
+	// assignment first releases this pool's own.
+	NodePool(NodePool&& other) noexcept;
+	NodePool& operator=(NodePool&& other) noexcept;
+	~NodePool();
+
+	// Constructs a node from args in a free slot.
+	template<class... Args>
+	NodeType* create(Args&&... args);
+	// Returns node's slot to the free list. node must come from this pool
+	// (or one it adopted).
+	void destroy(NodeType* node);
+	// Frees every page; all nodes from this pool become invalid.
+	void release();
+	// Takes over other's pages and free slots, leaving other empty, so
+	// nodes created by other now belong to this pool. O(other's pages),
+	// plus threading at most one page's never-used slots onto the free
+	// list when both pools have some.
+	void adopt(NodePool& other);
+
+	std::size_t pageCount() const;
+	// Total number of node slots across all pages.
+	std::size_t capacity() const;
+private:
+	union Slot
+	{
+		Slot* nextFree;
+		alignas(NodeType) unsigned char storage[sizeof(NodeType)];
+	};
+	struct Page
+	{
+		Slot* slots;
+		std::size_t count;
+	};
+
+	std::vector<Page> pages;
+	Slot* freeHead;
+	Slot* freeTail;  // lets adopt() splice free lists in O(1)
+	Slot* bump;      // next never-used slot of the newest page
+	Slot* bumpEnd;
+	std::size_t nextPageNodes;  // size of the next page addPage() makes
+
+	Slot* allocateSlot();
+	void addPage();
+	// Moves other's pages and slots into this empty pool.
+	void takeOver(NodePool& other) noexcept;
+	// Puts the never-used slots [first, last) on the free list.
+	void freeRange(Slot* first, Slot* last);
+};
+
+template<class NodeType>
+NodePool<NodeType>::NodePool()
+	: freeHead(nullptr), freeTail(nullptr), bump(nullptr), bumpEnd(nullptr), nextPageNodes(FIRST_PAGE_NODES)
+{
+}
+
+template<class NodeType>
+NodePool<NodeType>::NodePool(NodePool&& other) noexcept : NodePool()
+{
+	takeOver(other);
+}
+
+template<class NodeType>
+NodePool<NodeType>& NodePool<NodeType>::operator=(NodePool&& other) noexcept
+{
+	if (&other != this)
+	{
+		release();
+		takeOver(other);
+	}
+	return *this;
+}  // end operator=
+
+template<class NodeType>
+void NodePool<NodeType>::takeOver(NodePool& other) noexcept
+{
+	pages.swap(other.pages);
+	std::swap(freeHead, other.freeHead);
+	std::swap(freeTail, other.freeTail);
+	std::swap(bump, other.bump);
+	std::swap(bumpEnd, other.bumpEnd);
+	std::swap(nextPageNodes, other.nextPageNodes);
+}  // end takeOver
+
+template<class NodeType>
+NodePool<NodeType>::~NodePool()
+{
+	release();
+}
+
+template<class NodeType>
+template<class... Args>
+NodeType* NodePool<NodeType>::create(Args&&... args)
+{
+	Slot* slot = allocateSlot();
+	return new (slot->storage) NodeType(std::forward<Args>(args)...);
+}  // end create
+
+template<class NodeType>
+void NodePool<NodeType>::destroy(NodeType* node)
+{
+	Slot* slot = reinterpret_cast<Slot*>(node);
+	slot->nextFree = freeHead;
+	if (freeHead == nullptr)
+		freeTail = slot;
+	freeHead = slot;
+}  // end destroy
+
+template<class NodeType>
+typename NodePool<NodeType>::Slot* NodePool<NodeType>::allocateSlot()
+{
+	if (freeHead != nullptr)
+	{
+		Slot* slot = freeHead;
+		freeHead = slot->nextFree;
+		if (freeHead == nullptr)
+			freeTail = nullptr;
+		return slot;
+	}
+	if (bump == bumpEnd)
+		addPage();
+	return bump++;
+}  // end allocateSlot
+
+template<class NodeType>
+void NodePool<NodeType>::addPage()
+{
+	// Double the page size each time, up to MAX_PAGE_BYTES per page.
+	const std::size_t maxNodes = (MAX_PAGE_BYTES / sizeof(Slot) > 0) ? MAX_PAGE_BYTES / sizeof(Slot) : 1;
+	const std::size_t count = (nextPageNodes < maxNodes) ? nextPageNodes : maxNodes;
+	Page page;
+	page.slots = static_cast<Slot*>(::operator new(count * sizeof(Slot)));
+	page.count = count;
+	pages.push_back(page);
+	bump = page.slots;
+	bumpEnd = page.slots + count;
+	nextPageNodes = count * 2;
+}  // end addPage
+
+template<class NodeType>
+void NodePool<NodeType>::release()
+{
+	for (const Page& page : pages)
+		::operator delete(page.slots);
+	pages.clear();
+	freeHead = freeTail = nullptr;
+	bump = bumpEnd = nullptr;
+	nextPageNodes = FIRST_PAGE_NODES;
+}  // end release
+
+template<class NodeType>
+void NodePool<NodeType>::freeRange(Slot* first, Slot* last)
+{
+	if (first == last)
+		return;
+	for (Slot* slot = first; slot + 1 != last; slot++)
+		slot->nextFree = slot + 1;
+	(last - 1)->nextFree = freeHead;
+	if (freeHead == nullptr)
+		freeTail = last - 1;
+	freeHead = first;
+}  // end freeRange
+
+template<class NodeType>
+void NodePool<NodeType>::adopt(NodePool& other)
+{
+	if (&other == this)
+		return;
+	// Keep bumping through the larger never-used range and free the
+	// smaller one slot by slot, so neither is lost until release().
+	if (other.bumpEnd - other.bump > bumpEnd - bump)
+	{
+		std::swap(bump, other.bump);
+		std::swap(bumpEnd, other.bumpEnd);
+	}
+	freeRange(other.bump, other.bumpEnd);
+	pages.insert(pages.end(), other.pages.begin(), other.pages.end());
+	if (other.nextPageNodes > nextPageNodes)
+		nextPageNodes = other.nextPageNodes;
+	if (other.freeHead != nullptr)
+	{
+		other.freeTail->nextFree = freeHead;
+		if (freeHead == nullptr)
+			freeTail = other.freeTail;
+		freeHead = other.freeHead;
+	}
+	other.pages.clear();
+	other.freeHead = other.freeTail = nullptr;
+	other.bump = other.bumpEnd = nullptr;
+	other.nextPageNodes = FIRST_PAGE_NODES;
+}  // end adopt
+
+template<class NodeType>
+std::size_t NodePool<NodeType>::pageCount() const
+{
+	return pages.size();
+}  // end pageCount
+
+template<class NodeType>
+std::size_t NodePool<NodeType>::capacity() const
+{
+	std::size_t total = 0;
+	for (const Page& page : pages)
+		total += page.count;
+	return total;
+}  // end capacity
+
+// The chains built on pools rely on this for their own noexcept moves.
+static_assert(std::is_nothrow_move_constructible<NodePool<int>>::value, "NodePool moves must not throw");
+
+#endif
@@ -0,0 +1,181 @@
+// Allen Lim
+
+/** Fixed-size pool of worker threads fed from one task queue.
+ @file ThreadPool.h */
+
+#ifndef THREAD_POOL_
+#define THREAD_POOL_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ThreadPool;
+
+// Where and how widely a parallel algorithm runs; each algorithm's options
+// extend this with its own settings.
+struct ParallelOptions
+{
+	// Threads used at once, counting the calling thread; 0 uses one per
+	// pool worker.
+	unsigned threadCount = 0;
+	// Pool to run on; nullptr uses ThreadPool::shared().
+	ThreadPool* pool = nullptr;
+};
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex queueMutex;
+	std::condition_variable queueReady;
+	bool stopping;
+
+	void workerLoop();
+public:
+	// threadCount == 0 starts one worker per hardware thread.
+	explicit ThreadPool(unsigned threadCount = 0);
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	~ThreadPool();
+
+	unsigned size() const;
+
+	// Queues task and returns a future for its result.
+	template<class Task>
+	std::future<decltype(std::declval<Task&>()())> submit(Task task);
+
+	// Calls task(i) for every i in [first, last), on up to threadCount
+	// threads counting the calling thread (0: one per worker). Threads take
+	// the next unclaimed index in turn, so uneven tasks balance out; returns
+	// once every call has finished, rethrowing the first exception.
+	template<class Task>
+	void parallelFor(std::size_t first, std::size_t last, unsigned threadCount, Task task);
+
+	// Pool shared by callers that do not bring their own.
+	static ThreadPool& shared();
+	// options.pool, or shared() if it is nullptr.
+	static ThreadPool& of(const ParallelOptions& options);
+};
+
+inline ThreadPool::ThreadPool(unsigned threadCount) : stopping(false)
+{
+	if (threadCount == 0)
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned i = 0; i < threadCount; i++)
+		workers.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		stopping = true;
+	}
+	queueReady.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+inline unsigned ThreadPool::size() const
+{
+	return static_cast<unsigned>(workers.size());
+}
+
+inline void ThreadPool::workerLoop()
+{
+	while (true)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return;
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
+
+template<class Task>
+std::future<decltype(std::declval<Task&>()())> ThreadPool::submit(Task task)
+{
+	using Result = decltype(std::declval<Task&>()());
+	auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+	std::future<Result> result = packaged->get_future();
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		tasks.push([packaged] { (*packaged)(); });
+	}
+	queueReady.notify_one();
+	return result;
+}
+
+template<class Task>
+void ThreadPool::parallelFor(std::size_t first, std::size_t last, unsigned threadCount, Task task)
+{
+	if (first >= last)
+		return;
+	std::atomic<std::size_t> next(first);
+	auto work = [&]
+	{
+		try
+		{
+			for (std::size_t i = next++; i < last; i = next++)
+				task(i);
+		}
+		catch (...)
+		{
+			// Hand out no more indices once any call has failed.
+			next = last;
+			throw;
+		}
+	};
+	const std::size_t threads = std::min<std::size_t>((threadCount != 0) ? threadCount : size(), last - first);
+	std::vector<std::future<void>> helpers;
+	for (std::size_t t = 1; t < threads; t++)
+		helpers.push_back(submit(work));
+	std::exception_ptr failure;
+	try
+	{
+		work();
+	}
+	catch (...)
+	{
+		failure = std::current_exception();
+	}
+	// The helpers use next and task, so all of them must finish before
+	// this frame goes away, whichever one failed.
+	for (std::future<void>& helper : helpers)
+		helper.wait();
+	if (failure)
+		std::rethrow_exception(failure);
+	for (std::future<void>& helper : helpers)
+		helper.get();
+}  // end parallelFor
+
+inline ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+inline ThreadPool& ThreadPool::of(const ParallelOptions& options)
+{
+	return (options.pool != nullptr) ? *options.pool : shared();
+}
+
+#endif